@@ -0,0 +1,561 @@
+/**
+ * @file       bench.c
+ * @date       10/2026
+ * @brief      Times every List_* operation and full traversals on lists of
+ * 1e3 to 1e7 items
+ * **********************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * Usage: bench [-n min] [-N max] [-r repeats] [-j file.json]
+ *
+ * Sizes go from min to max (default 1e3 to 1e7) by factors of ten. Every
+ * repeat builds a list of the given size, runs all operations on it in a
+ * fixed order and frees it again. For every operation and size the mean,
+ * standard deviation and minimum of ns/op over the repeats are reported,
+ * together with hardware counters per operation when perf_event_open is
+ * permitted. With -j the results are also written as JSON ("-" is stdout,
+ * the table then goes to stderr).
+ */
+
+#define _GNU_SOURCE
+
+/* Private includes -------------------------------------------------------- */
+#include <fcntl.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+#include "../src/aggregate.h"
+#include "../src/list.h"
+#include "../src/order.h"
+#include "../src/sketch.h"
+#include "../src/topk.h"
+
+#define DEFAULT_MIN 1000L
+#define DEFAULT_MAX 10000000L
+#define DEFAULT_REPEATS 5
+#define MAX_REPEATS 100
+/** Most List_Seek and List_Position calls per repeat */
+#define MAX_SEEKS 100000L
+/** Items found by List_Top_K */
+#define TOP_K 100
+/** List_Quantile and List_Stddev calls per repeat */
+#define QUANTILES 1000
+
+/** Hardware counters, in the order of the perf group */
+enum {
+    COUNTER_INSTRUCTIONS,
+    COUNTER_CYCLES,
+    COUNTER_CACHE_MISSES,
+    COUNTER_BRANCH_MISSES,
+    COUNTER_COUNT
+};
+
+static const char* const counterNames[COUNTER_COUNT] = {
+    "instructions", "cycles", "cache_misses", "branch_misses"};
+
+typedef enum {
+    OP_INSERT_FIRST,
+    OP_TRAVERSE_API,
+    OP_TRAVERSE_RAW,
+    OP_COPY,
+    OP_ACTUALIZE,
+    OP_COPY_FIRST,
+    OP_IS_ACTIVE,
+    OP_DUMP,
+    OP_REVERSE,
+    OP_PARTITION,
+    OP_TOP_K,
+    OP_SKETCH_ATTACH,
+    OP_QUANTILE,
+    OP_AGGREGATE_ATTACH,
+    OP_STDDEV,
+    OP_ORDER_ATTACH,
+    OP_SEEK,
+    OP_POSITION,
+    OP_DELETE_FIRST,
+    OP_POST_INSERT,
+    OP_POST_DELETE,
+    OP_INIT,
+    OP_COUNT
+} Bench_Op_t;
+
+static const char* const opNames[OP_COUNT] = {
+    "Insert_First", "First+Succ traversal", "raw traversal", "Copy+Succ",
+    "Actualize+Succ", "Copy_First", "Is_Active", "Dump", "Reverse", "Partition",
+    "Top_K (k=100)", "Sketch_Attach", "Quantile (sketched)",
+    "Aggregate_Attach", "Stddev (aggregated)", "Order_Attach",
+    "Seek (indexed)", "Seek+Position (indexed)", "Delete_First",
+    "Post_Insert", "Post_Delete", "Init"};
+
+typedef struct {
+    double ns[MAX_REPEATS];     /**< ns/op of every repeat */
+    double counters[COUNTER_COUNT]; /**< sum of counters over repeats */
+    long ops;                   /**< operations per repeat */
+    int repeats;
+} Bench_Result_t;
+
+typedef struct {
+    int fds[COUNTER_COUNT];
+    bool enabled;
+    uint64_t values[COUNTER_COUNT];
+} Bench_Perf_t;
+
+static volatile double sink;
+static Bench_Perf_t perf;
+static int devNull = -1;
+
+/* Private functions ------------------------------------------------------- */
+
+static bool odd_age(const Data_t* data, void* context) {
+    (void)context;
+    return (long)data->age % 2 != 0;
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+#ifdef __linux__
+static int perf_open(uint32_t type, uint64_t config, int group) {
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = group < 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+static void perf_init(void) {
+    static const uint64_t configs[COUNTER_COUNT] = {
+        PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+    perf.enabled = true;
+    for(int i = 0; i < COUNTER_COUNT; i++) {
+        perf.fds[i] = perf_open(PERF_TYPE_HARDWARE, configs[i], i ? perf.fds[0] : -1);
+        if(perf.fds[i] < 0) {
+            for(int j = 0; j < i; j++)
+                close(perf.fds[j]);
+            perf.enabled = false;
+            return;
+        }
+    }
+}
+
+static void perf_start(void) {
+    if(!perf.enabled)
+        return;
+    ioctl(perf.fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(perf.fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+static void perf_stop(void) {
+    uint64_t buffer[1 + COUNTER_COUNT];
+
+    if(!perf.enabled)
+        return;
+    ioctl(perf.fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    if(read(perf.fds[0], buffer, sizeof(buffer)) != (ssize_t)sizeof(buffer)) {
+        memset(perf.values, 0, sizeof(perf.values));
+        return;
+    }
+    memcpy(perf.values, buffer + 1, sizeof(perf.values));
+}
+#else
+static void perf_init(void) {
+    perf.enabled = false;
+}
+
+static void perf_start(void) {
+}
+
+static void perf_stop(void) {
+}
+#endif
+
+static void measure_begin(double* start) {
+    perf_start();
+    *start = now_ns();
+}
+
+static void measure_end(Bench_Result_t* result, double start, long ops) {
+    double elapsed = now_ns() - start;
+
+    perf_stop();
+    if(ops < 1)
+        ops = 1;
+    result->ns[result->repeats] = elapsed / ops;
+    result->ops = ops;
+    for(int i = 0; i < COUNTER_COUNT && perf.enabled; i++)
+        result->counters[i] += (double)perf.values[i] / ops;
+    result->repeats++;
+}
+
+static void make_data(Data_t* data, long i) {
+    snprintf(data->name, sizeof(data->name), "Item %ld", i);
+    data->age = (double)(i % 90);
+    data->weight = 50.0 + (double)(i % 50);
+    data->height = 150.0 + (double)(i % 50);
+}
+
+/**
+ * @brief Runs all operations once on a list of the given size
+ * @return Returns false if the list could not be built
+ */
+static bool run_once(long size, Bench_Result_t* results) {
+    const List_Node_t* top[TOP_K];
+    List_t list;
+    Data_t data;
+    double start;
+    long count;
+
+    make_data(&data, 0);
+    List_Init(&list);
+
+    measure_begin(&start);
+    for(long i = 0; i < size; i++) {
+        data.age = (double)(i % 90);
+        List_Insert_First(&list, data);
+    }
+    measure_end(&results[OP_INSERT_FIRST], start, size);
+
+    count = 0;
+    for(List_Node_t* node = list.first; node; node = node->next)
+        count++;
+    if(count != size) {
+        while(list.first)
+            List_Delete_First(&list);
+        return false;
+    }
+
+    measure_begin(&start);
+    List_First(&list);
+    while(List_Is_Active(list))
+        List_Succ(&list);
+    measure_end(&results[OP_TRAVERSE_API], start, size);
+
+    measure_begin(&start);
+    {
+        double sum = 0;
+        for(const List_Node_t* node = list.first; node; node = node->next)
+            sum += node->data.age;
+        sink = sum;
+    }
+    measure_end(&results[OP_TRAVERSE_RAW], start, size);
+
+    measure_begin(&start);
+    {
+        double sum = 0;
+        List_First(&list);
+        while(List_Copy(list, &data)) {
+            sum += data.age;
+            List_Succ(&list);
+        }
+        sink = sum;
+    }
+    measure_end(&results[OP_COPY], start, size);
+
+    measure_begin(&start);
+    List_First(&list);
+    while(List_Is_Active(list)) {
+        List_Actualize(&list, data);
+        List_Succ(&list);
+    }
+    measure_end(&results[OP_ACTUALIZE], start, size);
+
+    measure_begin(&start);
+    {
+        double sum = 0;
+        for(long i = 0; i < size; i++) {
+            List_Copy_First(list, &data);
+            sum += data.age;
+        }
+        sink = sum;
+    }
+    measure_end(&results[OP_COPY_FIRST], start, size);
+
+    List_First(&list);
+    measure_begin(&start);
+    {
+        long active = 0;
+        for(long i = 0; i < size; i++)
+            active += List_Is_Active(list);
+        sink = (double)active;
+    }
+    measure_end(&results[OP_IS_ACTIVE], start, size);
+
+    measure_begin(&start);
+    List_Dump(list, devNull);
+    measure_end(&results[OP_DUMP], start, size);
+
+    measure_begin(&start);
+    List_Reverse(&list);
+    measure_end(&results[OP_REVERSE], start, size);
+
+    measure_begin(&start);
+    sink = (double)List_Partition(&list, odd_age, NULL);
+    measure_end(&results[OP_PARTITION], start, size);
+
+    measure_begin(&start);
+    sink = (double)List_Top_K(list, DATA_FIELD_AGE, TOP_K, true, top);
+    measure_end(&results[OP_TOP_K], start, size);
+
+    measure_begin(&start);
+    if(!List_Sketch_Attach(&list, 0.01)) {
+        while(list.first)
+            List_Delete_First(&list);
+        return false;
+    }
+    measure_end(&results[OP_SKETCH_ATTACH], start, size);
+
+    measure_begin(&start);
+    {
+        double value, sum = 0;
+        for(long i = 0; i < QUANTILES; i++) {
+            List_Quantile(list, DATA_FIELD_WEIGHT, 0.99, &value);
+            sum += value;
+        }
+        sink = sum;
+    }
+    measure_end(&results[OP_QUANTILE], start, QUANTILES);
+    List_Sketch_Detach(&list);
+
+    measure_begin(&start);
+    if(!List_Aggregate_Attach(&list)) {
+        while(list.first)
+            List_Delete_First(&list);
+        return false;
+    }
+    measure_end(&results[OP_AGGREGATE_ATTACH], start, size);
+
+    measure_begin(&start);
+    {
+        double value, sum = 0;
+        for(long i = 0; i < QUANTILES; i++) {
+            List_Stddev(list, DATA_FIELD_WEIGHT, &value);
+            sum += value;
+        }
+        sink = sum;
+    }
+    measure_end(&results[OP_STDDEV], start, QUANTILES);
+    List_Aggregate_Detach(&list);
+
+    measure_begin(&start);
+    if(!List_Order_Attach(&list)) {
+        while(list.first)
+            List_Delete_First(&list);
+        return false;
+    }
+    measure_end(&results[OP_ORDER_ATTACH], start, size);
+
+    count = size < MAX_SEEKS ? size : MAX_SEEKS;
+    measure_begin(&start);
+    {
+        uint64_t random = 1;
+        for(long i = 0; i < count; i++) {
+            random = random * 6364136223846793005u + 1442695040888963407u;
+            List_Seek(&list, (size_t)((random >> 33) % (uint64_t)size));
+        }
+    }
+    measure_end(&results[OP_SEEK], start, count);
+
+    measure_begin(&start);
+    {
+        uint64_t random = 1;
+        size_t position, sum = 0;
+        for(long i = 0; i < count; i++) {
+            random = random * 6364136223846793005u + 1442695040888963407u;
+            List_Seek(&list, (size_t)((random >> 33) % (uint64_t)size));
+            List_Position(list, &position);
+            sum += position;
+        }
+        sink = (double)sum;
+    }
+    measure_end(&results[OP_POSITION], start, count);
+    List_Order_Detach(&list);
+
+    measure_begin(&start);
+    for(long i = 0; i < size; i++)
+        List_Delete_First(&list);
+    measure_end(&results[OP_DELETE_FIRST], start, size);
+
+    List_Insert_First(&list, data);
+    List_First(&list);
+    measure_begin(&start);
+    for(long i = 1; i < size; i++)
+        List_Post_Insert(&list, data);
+    measure_end(&results[OP_POST_INSERT], start, size - 1);
+
+    measure_begin(&start);
+    for(long i = 1; i < size; i++)
+        List_Post_Delete(&list);
+    measure_end(&results[OP_POST_DELETE], start, size - 1);
+
+    List_Delete_First(&list);
+    measure_begin(&start);
+    for(long i = 0; i < size; i++)
+        List_Init(&list);
+    measure_end(&results[OP_INIT], start, size);
+    return true;
+}
+
+static void statistics(const Bench_Result_t* r, double* mean, double* stddev,
+                       double* min) {
+    double sum = 0, squares = 0;
+
+    *min = r->ns[0];
+    for(int i = 0; i < r->repeats; i++) {
+        sum += r->ns[i];
+        if(r->ns[i] < *min)
+            *min = r->ns[i];
+    }
+    *mean = sum / r->repeats;
+    for(int i = 0; i < r->repeats; i++)
+        squares += (r->ns[i] - *mean) * (r->ns[i] - *mean);
+    *stddev = r->repeats > 1 ? sqrt(squares / (r->repeats - 1)) : 0.0;
+}
+
+static void print_table(FILE* out, long size, const Bench_Result_t* results) {
+    fprintf(out, "\n%ld items\n", size);
+    fprintf(out, "%-22s %10s %9s %10s %14s", "operation", "ns/op", "stddev",
+            "min", "ops/s");
+    if(perf.enabled)
+        fprintf(out, " %9s %9s %9s", "instr/op", "cyc/op", "miss/op");
+    fputc('\n', out);
+
+    for(int op = 0; op < OP_COUNT; op++) {
+        const Bench_Result_t* r = &results[op];
+        double mean, stddev, min;
+
+        statistics(r, &mean, &stddev, &min);
+        fprintf(out, "%-22s %10.2f %9.2f %10.2f %14.0f", opNames[op], mean, stddev,
+                min, mean > 0 ? 1e9 / mean : 0.0);
+        if(perf.enabled)
+            fprintf(out, " %9.1f %9.1f %9.3f",
+                    r->counters[COUNTER_INSTRUCTIONS] / r->repeats,
+                    r->counters[COUNTER_CYCLES] / r->repeats,
+                    r->counters[COUNTER_CACHE_MISSES] / r->repeats);
+        fputc('\n', out);
+    }
+    fflush(out);
+}
+
+static void print_json(FILE* out, long size, const Bench_Result_t* results,
+                       bool* first) {
+    for(int op = 0; op < OP_COUNT; op++) {
+        const Bench_Result_t* r = &results[op];
+        double mean, stddev, min;
+
+        statistics(r, &mean, &stddev, &min);
+        fprintf(out,
+                "%s\n    {\"op\": \"%s\", \"size\": %ld, \"ops\": %ld, "
+                "\"repeats\": %d, \"ns_per_op\": %.3f, \"stddev\": %.3f, "
+                "\"min\": %.3f, \"ops_per_sec\": %.0f",
+                *first ? "" : ",", opNames[op], size, r->ops, r->repeats, mean,
+                stddev, min, mean > 0 ? 1e9 / mean : 0.0);
+        for(int c = 0; c < COUNTER_COUNT; c++) {
+            if(perf.enabled)
+                fprintf(out, ", \"%s_per_op\": %.3f", counterNames[c],
+                        r->counters[c] / r->repeats);
+            else
+                fprintf(out, ", \"%s_per_op\": null", counterNames[c]);
+        }
+        fputc('}', out);
+        *first = false;
+    }
+}
+
+int main(int argc, char** argv) {
+    Bench_Result_t results[OP_COUNT];
+    long minSize = DEFAULT_MIN, maxSize = DEFAULT_MAX;
+    int repeats = DEFAULT_REPEATS;
+    const char* jsonPath = NULL;
+    FILE* json = NULL;
+    FILE* table = stdout;
+    bool first = true;
+    bool ok = true;
+    int opt;
+
+    while((opt = getopt(argc, argv, "n:N:r:j:h")) != -1) {
+        switch(opt) {
+        case 'n':
+            minSize = atol(optarg);
+            break;
+        case 'N':
+            maxSize = atol(optarg);
+            break;
+        case 'r':
+            repeats = atoi(optarg);
+            break;
+        case 'j':
+            jsonPath = optarg;
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-n min] [-N max] [-r repeats] [-j file.json]\n",
+                    argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if(minSize < 1 || maxSize < minSize || repeats < 1 || repeats > MAX_REPEATS) {
+        fprintf(stderr, "Invalid sizes or repeats (1-%d)\n", MAX_REPEATS);
+        return 1;
+    }
+
+    if(jsonPath) {
+        if(strcmp(jsonPath, "-") == 0) {
+            json = stdout;
+            table = stderr;
+        } else if(!(json = fopen(jsonPath, "w"))) {
+            fprintf(stderr, "Can't create %s\n", jsonPath);
+            return 1;
+        }
+    }
+    devNull = open("/dev/null", O_WRONLY);
+    perf_init();
+    fprintf(table, "hardware counters: %s\n",
+            perf.enabled ? "perf_event_open" : "not available");
+    if(json)
+        fprintf(json, "{\n  \"benchmark\": \"list\",\n  \"repeats\": %d,\n"
+                      "  \"perf_counters\": %s,\n  \"results\": [",
+                repeats, perf.enabled ? "true" : "false");
+
+    for(long size = minSize; size <= maxSize && ok; size *= 10) {
+        memset(results, 0, sizeof(results));
+        for(int r = 0; r < repeats && ok; r++)
+            ok = run_once(size, results);
+        if(!ok) {
+            fprintf(stderr, "Out of memory at %ld items\n", size);
+            break;
+        }
+        print_table(table, size, results);
+        if(json)
+            print_json(json, size, results, &first);
+        if(size > maxSize / 10)
+            break;
+    }
+
+    if(json) {
+        fprintf(json, "\n  ]\n}\n");
+        if(json != stdout)
+            fclose(json);
+    }
+    if(devNull >= 0)
+        close(devNull);
+    return ok ? 0 : 1;
+}
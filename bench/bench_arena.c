@@ -0,0 +1,352 @@
+/**
+ * @file       bench_arena.c
+ * @date       10/2026
+ * @brief      Compares list traversals with items from malloc and from the
+ * node arena with and without huge pages, and of the index-linked IList_t
+ * **********************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * Usage: bench_arena [-n items] [-r repeats]
+ *
+ * For every allocation backend, and for an IList_t in its arrays, a list of
+ * -n items (default 4000000) is allocated and traversed twice: once linked in allocation order and once
+ * linked in a random order, which is what a list looks like after a long
+ * run of inserts and deletes. The best time of -r repeats (default 5) is
+ * reported per item, together with dTLB load misses per item when
+ * perf_event_open is permitted and the huge pages backing the process
+ * (AnonHugePages of /proc/self/smaps_rollup).
+ */
+
+#define _GNU_SOURCE
+
+/* Private includes -------------------------------------------------------- */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+#include "../src/arena.h"
+#include "../src/ilist.h"
+#include "../src/list.h"
+
+#define DEFAULT_ITEMS 4000000L
+#define DEFAULT_REPEATS 5
+
+typedef enum {
+    BACKEND_MALLOC,
+    BACKEND_ARENA,
+    BACKEND_ARENA_HUGE,
+    BACKEND_ILIST,
+    BACKEND_COUNT
+} Backend_t;
+
+static const char* const backendNames[BACKEND_COUNT] = {"malloc", "arena 4k",
+                                                        "arena huge", "ilist"};
+
+static volatile double sink;
+static int perfFd = -1;
+
+/* Private functions ------------------------------------------------------- */
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void perf_init(void) {
+#ifdef __linux__
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    perfFd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+}
+
+static void perf_start(void) {
+#ifdef __linux__
+    if(perfFd < 0)
+        return;
+    ioctl(perfFd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(perfFd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+}
+
+/** Returns dTLB load misses since perf_start, -1 if not available */
+static long long perf_stop(void) {
+#ifdef __linux__
+    uint64_t value;
+
+    if(perfFd < 0)
+        return -1;
+    ioctl(perfFd, PERF_EVENT_IOC_DISABLE, 0);
+    if(read(perfFd, &value, sizeof(value)) != (ssize_t)sizeof(value))
+        return -1;
+    return (long long)value;
+#else
+    return -1;
+#endif
+}
+
+/** Returns AnonHugePages of the process in KiB, -1 if unknown */
+static long huge_pages_kb(void) {
+    FILE* f = fopen("/proc/self/smaps_rollup", "r");
+    char line[256];
+    long kb = -1;
+
+    if(!f)
+        return -1;
+    while(fgets(line, sizeof(line), f)) {
+        if(sscanf(line, "AnonHugePages: %ld kB", &kb) == 1)
+            break;
+    }
+    fclose(f);
+    return kb;
+}
+
+/** Links the allocated items in the given order, the last one first */
+static void link_items(List_t* list, List_Node_t** nodes, long items) {
+    list->first = NULL;
+    for(long i = items - 1; i >= 0; i--)
+        List_Link_After(list, NULL, nodes[i]);
+}
+
+static void shuffle(List_Node_t** nodes, long items) {
+    uint64_t random = 88172645463325252u;
+
+    for(long i = items - 1; i > 0; i--) {
+        long j;
+        List_Node_t* tmp;
+
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+        j = (long)(random % (uint64_t)(i + 1));
+        tmp = nodes[i];
+        nodes[i] = nodes[j];
+        nodes[j] = tmp;
+    }
+}
+
+static void shuffle_indices(uint32_t* order, long items) {
+    uint64_t random = 88172645463325252u;
+
+    for(long i = items - 1; i > 0; i--) {
+        long j;
+        uint32_t tmp;
+
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+        j = (long)(random % (uint64_t)(i + 1));
+        tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+}
+
+/** Traverses the list repeats times, returns the best ns per item */
+static double traverse(List_t* list, long items, int repeats, long long* misses) {
+    double best = -1;
+
+    *misses = -1;
+    for(int r = 0; r < repeats; r++) {
+        double start, elapsed, sum = 0;
+        long long m;
+
+        perf_start();
+        start = now_ns();
+        for(List_First(list); List_Is_Active(*list); List_Succ(list))
+            sum += list->active->data.age;
+        elapsed = now_ns() - start;
+        m = perf_stop();
+        sink = sum;
+        if(best < 0 || elapsed < best) {
+            best = elapsed;
+            *misses = m;
+        }
+    }
+    return best / items;
+}
+
+/** Links the items of an IList_t in the given order of indices */
+static void link_indices(IList_t* list, const uint32_t* order, long items) {
+    list->first = order[0];
+    for(long i = 0; i + 1 < items; i++)
+        list->next[order[i]] = order[i + 1];
+    list->next[order[items - 1]] = 0;
+}
+
+static double traverse_ilist(IList_t* list, long items, int repeats, long long* misses) {
+    double best = -1;
+
+    *misses = -1;
+    for(int r = 0; r < repeats; r++) {
+        double start, elapsed, sum = 0;
+        long long m;
+
+        perf_start();
+        start = now_ns();
+        for(IList_First(list); IList_Is_Active(list); IList_Succ(list))
+            sum += list->data[list->active].age;
+        elapsed = now_ns() - start;
+        m = perf_stop();
+        sink = sum;
+        if(best < 0 || elapsed < best) {
+            best = elapsed;
+            *misses = m;
+        }
+    }
+    return best / items;
+}
+
+static void print_misses(long long misses, long items) {
+    if(misses < 0)
+        printf(" %12s", "n/a");
+    else
+        printf(" %12.3f", (double)misses / items);
+}
+
+static void print_row(Backend_t backend, double seq, long long seqMisses, double rnd,
+                      long long rndMisses, long hugeBefore, long items) {
+    printf("%-10s %12.2f", backendNames[backend], seq);
+    print_misses(seqMisses, items);
+    printf(" %12.2f", rnd);
+    print_misses(rndMisses, items);
+    if(hugeBefore < 0)
+        printf(" %10s\n", "n/a");
+    else
+        printf(" %10ld\n", (huge_pages_kb() - hugeBefore) / 1024);
+}
+
+static bool run_ilist(long items, int repeats) {
+    uint32_t* order = malloc((size_t)items * sizeof(*order));
+    long hugeBefore = huge_pages_kb();
+    long long seqMisses, rndMisses;
+    double seq, rnd;
+    IList_t list;
+    Data_t data;
+
+    if(!order)
+        return false;
+    IList_Init(&list);
+    memset(&data, 0, sizeof(data));
+    for(long i = 0; i < items; i++) {
+        data.age = (double)(i % 90);
+        if(!IList_Insert_First(&list, data)) {
+            IList_Free(&list);
+            free(order);
+            return false;
+        }
+        order[i] = (uint32_t)(i + 1);
+    }
+
+    link_indices(&list, order, items);
+    seq = traverse_ilist(&list, items, repeats, &seqMisses);
+    shuffle_indices(order, items);
+    link_indices(&list, order, items);
+    rnd = traverse_ilist(&list, items, repeats, &rndMisses);
+    print_row(BACKEND_ILIST, seq, seqMisses, rnd, rndMisses, hugeBefore, items);
+
+    IList_Free(&list);
+    free(order);
+    return true;
+}
+
+static bool run(Backend_t backend, long items, int repeats) {
+    List_Node_t** nodes = malloc((size_t)items * sizeof(*nodes));
+    long hugeBefore = huge_pages_kb();
+    long long seqMisses, rndMisses;
+    double seq, rnd;
+    List_t list;
+
+    if(!nodes)
+        return false;
+    List_Init(&list);
+    if(backend != BACKEND_MALLOC &&
+       !List_Arena_Attach(&list, (size_t)items, backend == BACKEND_ARENA_HUGE)) {
+        free(nodes);
+        return false;
+    }
+
+    for(long i = 0; i < items; i++) {
+        nodes[i] = List_Node_Alloc(&list);
+        if(!nodes[i]) {
+            while(i--)
+                List_Node_Free(&list, nodes[i]);
+            List_Arena_Detach(&list);
+            free(nodes);
+            return false;
+        }
+        memset(&nodes[i]->data, 0, sizeof(nodes[i]->data));
+        nodes[i]->data.age = (double)(i % 90);
+    }
+
+    link_items(&list, nodes, items);
+    seq = traverse(&list, items, repeats, &seqMisses);
+    shuffle(nodes, items);
+    link_items(&list, nodes, items);
+    rnd = traverse(&list, items, repeats, &rndMisses);
+
+    print_row(backend, seq, seqMisses, rnd, rndMisses, hugeBefore, items);
+
+    while(list.first)
+        List_Delete_First(&list);
+    List_Arena_Detach(&list);
+    free(nodes);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    long items = DEFAULT_ITEMS;
+    int repeats = DEFAULT_REPEATS;
+    int result = 0;
+    int opt;
+
+    while((opt = getopt(argc, argv, "n:r:")) != -1) {
+        switch(opt) {
+        case 'n':
+            items = atol(optarg);
+            break;
+        case 'r':
+            repeats = atoi(optarg);
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-n items] [-r repeats]\n", argv[0]);
+            return 1;
+        }
+    }
+    if(items < 1 || repeats < 1) {
+        fprintf(stderr, "Invalid number of items or repeats\n");
+        return 1;
+    }
+
+    perf_init();
+    printf("%ld items of %zu bytes, best of %d traversals%s\n", items, sizeof(List_Node_t),
+           repeats, perfFd < 0 ? ", dTLB counter not permitted" : "");
+    printf("%-10s %12s %12s %12s %12s %10s\n", "backend", "seq ns/item", "seq dTLB/it",
+           "rnd ns/item", "rnd dTLB/it", "huge MiB");
+    for(int b = 0; b < BACKEND_COUNT; b++) {
+        bool ok = b == BACKEND_ILIST ? run_ilist(items, repeats)
+                                     : run((Backend_t)b, items, repeats);
+
+        if(!ok) {
+            printf("%-10s failed\n", backendNames[b]);
+            result = 1;
+        }
+    }
+    return result;
+}
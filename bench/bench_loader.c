@@ -0,0 +1,268 @@
+/**
+ * @file       bench_loader.c
+ * @date       10/2026
+ * @brief      Compares loading of a record file through Data_Get with the
+ * memory mapped List_Load_Text loader, and the restart paths of a binary
+ * snapshot (List_Load) and a persistent list (PList_Open)
+ * **********************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * Usage: bench_loader [records] [file]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/* Private includes -------------------------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include "../src/data.h"
+#include "../src/list.h"
+#include "../src/loader.h"
+#include "../src/plist.h"
+#include "../src/snapshot.h"
+
+#define DEFAULT_RECORDS 1000000L
+#define REPEATS 3
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void list_free(List_t* list) {
+    while(list->first)
+        List_Delete_First(list);
+}
+
+static bool write_records(const char* path, long records) {
+    static const char* names[] = {"Franta", "Pepa", "Alena", "Jana", "Hana",
+                                  "Roman"};
+    FILE* f = fopen(path, "w");
+    if(!f)
+        return false;
+    srand(42);
+    for(long i = 0; i < records; i++)
+        fprintf(f, "%s %ld\n%d\n%d.%d\n%d.5\n", names[i % 6], i, 18 + rand() % 60,
+                45 + rand() % 70, rand() % 10, 150 + rand() % 50);
+    return fclose(f) == 0;
+}
+
+static double bench_data_get(const char* path, size_t* loaded) {
+    List_t list;
+    Data_t data;
+    List_Node_t* last = NULL;
+    double start;
+
+    *loaded = 0;
+    if(!freopen(path, "r", stdin))
+        return -1;
+    /* Data_Get prompts on stdout for every record */
+    if(!freopen("/dev/null", "w", stdout))
+        return -1;
+
+    List_Init(&list);
+    start = now();
+    while(Data_Get(&data)) {
+        last = List_Insert_After(&list, last, data);
+        (*loaded)++;
+    }
+    start = now() - start;
+    list_free(&list);
+    return start;
+}
+
+/* parsing alone, records are not stored anywhere */
+static double bench_parse_data_get(const char* path, size_t* parsed) {
+    Data_t data;
+    double start;
+
+    *parsed = 0;
+    if(!freopen(path, "r", stdin))
+        return -1;
+    start = now();
+    while(Data_Get(&data))
+        (*parsed)++;
+    return now() - start;
+}
+
+static double bench_parse_memory(const char* path, size_t* parsed) {
+    FILE* f = fopen(path, "rb");
+    Data_t data;
+    char* text;
+    const char* p;
+    long size;
+    double start;
+
+    *parsed = 0;
+    if(!f)
+        return -1;
+    fseek(f, 0, SEEK_END);
+    size = ftell(f);
+    rewind(f);
+    text = malloc(size);
+    if(!text || fread(text, 1, size, f) != (size_t)size) {
+        free(text);
+        fclose(f);
+        return -1;
+    }
+    fclose(f);
+
+    p = text;
+    start = now();
+    while(Data_Parse(&p, text + size, &data))
+        (*parsed)++;
+    start = now() - start;
+    free(text);
+    return start;
+}
+
+static double bench_mmap(const char* path, size_t* loaded) {
+    List_t list;
+    double start;
+
+    List_Init(&list);
+    start = now();
+    if(!List_Load_Text(&list, path, loaded))
+        start = -1;
+    else
+        start = now() - start;
+    list_free(&list);
+    return start;
+}
+
+static double bench_parallel(const char* path, size_t* loaded) {
+    List_t list;
+    double start;
+
+    List_Init(&list);
+    start = now();
+    if(!List_Load_Text_Parallel(&list, path, 0, loaded))
+        start = -1;
+    else
+        start = now() - start;
+    list_free(&list);
+    return start;
+}
+
+/* writes the records of the text file as a snapshot and a persistent list */
+static bool write_restart_files(const char* path, const char* snapshot,
+                                const char* persistent) {
+    List_t list;
+    PList_t plist;
+    bool ok;
+
+    List_Init(&list);
+    remove(persistent);
+    ok = List_Load_Text(&list, path, NULL) && List_Save(&list, snapshot) &&
+         PList_Open(&plist, persistent);
+    if(ok) {
+        ok = PList_Import(&plist, list);
+        ok = PList_Close(&plist) && ok;
+    }
+    list_free(&list);
+    return ok;
+}
+
+static double bench_snapshot(const char* path, size_t* loaded) {
+    List_t list;
+    double start;
+
+    List_Init(&list);
+    start = now();
+    if(!List_Load(&list, path, loaded))
+        start = -1;
+    else
+        start = now() - start;
+    list_free(&list);
+    return start;
+}
+
+static double bench_plist_open(const char* path, size_t* loaded) {
+    PList_t plist;
+    Data_t data;
+    double start = now();
+
+    if(!PList_Open(&plist, path))
+        return -1;
+    PList_Copy_First(&plist, &data);
+    start = now() - start;
+    *loaded = PList_Count(&plist);
+    PList_Close(&plist);
+    return start;
+}
+
+/* best time of REPEATS runs, negative if any run failed */
+static double best_of(double (*bench)(const char*, size_t*), const char* path,
+                      size_t* count) {
+    double best = 1e30;
+    for(int i = 0; i < REPEATS; i++) {
+        double t = bench(path, count);
+        if(t < 0)
+            return t;
+        best = t < best ? t : best;
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    long records = argc > 1 ? atol(argv[1]) : DEFAULT_RECORDS;
+    const char* path = argc > 2 ? argv[2] : "bench_records.txt";
+    size_t fastCount, slowCount, parallelCount, parseSlowCount, parseFastCount;
+    size_t snapshotCount = 0, plistCount = 0;
+    double fast, slow, parallel, parseSlow, parseFast, snapshot = -1, plist = -1;
+    char snapshotPath[1024], plistPath[1024];
+
+    if(records <= 0 || !write_records(path, records)) {
+        fprintf(stderr, "Can't create %s\n", path);
+        return 1;
+    }
+
+    /* the first run only warms up the heap, all paths allocate the same
+     * number of items and should not pay for fresh pages */
+#ifdef __GLIBC__
+    mallopt(M_TRIM_THRESHOLD, 1 << 30);
+#endif
+    bench_mmap(path, &fastCount);
+    fast = best_of(bench_mmap, path, &fastCount);
+    parallel = best_of(bench_parallel, path, &parallelCount);
+    slow = best_of(bench_data_get, path, &slowCount);
+    parseSlow = best_of(bench_parse_data_get, path, &parseSlowCount);
+    parseFast = best_of(bench_parse_memory, path, &parseFastCount);
+    snprintf(snapshotPath, sizeof(snapshotPath), "%s.snap", path);
+    snprintf(plistPath, sizeof(plistPath), "%s.plist", path);
+    if(write_restart_files(path, snapshotPath, plistPath)) {
+        snapshot = best_of(bench_snapshot, snapshotPath, &snapshotCount);
+        plist = best_of(bench_plist_open, plistPath, &plistCount);
+    }
+    remove(path);
+    remove(snapshotPath);
+    remove(plistPath);
+
+    if(fast < 0 || slow < 0 || parallel < 0 || parseSlow < 0 || parseFast < 0 ||
+       fastCount != slowCount || parallelCount != slowCount ||
+       parseSlowCount != slowCount || parseFastCount != slowCount ||
+       snapshot < 0 || plist < 0 || snapshotCount != slowCount ||
+       plistCount != slowCount) {
+        fprintf(stderr, "Loading failed\n");
+        return 1;
+    }
+
+    fprintf(stderr, "records:        %zu (best of %d runs)\n", fastCount,
+            REPEATS);
+    fprintf(stderr, "parsing only:   Data_Get %.3f s, Data_Parse %.3f s, "
+            "speedup %.1fx\n", parseSlow, parseFast, parseSlow / parseFast);
+    fprintf(stderr, "Data_Get:       %.3f s (%.0f records/s)\n", slow,
+            slowCount / slow);
+    fprintf(stderr, "List_Load_Text: %.3f s (%.0f records/s), speedup %.1fx\n",
+            fast, fastCount / fast, slow / fast);
+    fprintf(stderr, "..._Parallel:   %.3f s (%.0f records/s), speedup %.1fx\n",
+            parallel, parallelCount / parallel, slow / parallel);
+    fprintf(stderr, "restart:        List_Load snapshot %.3f s, PList_Open %.6f s\n",
+            snapshot, plist);
+    return 0;
+}
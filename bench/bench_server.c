@@ -0,0 +1,190 @@
+/**
+ * @file       bench_server.c
+ * @date       10/2026
+ * @brief      Measures round trip latency and pipelined throughput of the
+ * UNIX socket server
+ * **********************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * Usage: bench_server [requests] [clients]
+ *
+ * The server runs in its own thread of this process, clients are threads
+ * with blocking sockets. Latency is measured with one request in flight,
+ * throughput with batches of pipelined Insert_First requests.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/* Private includes -------------------------------------------------------- */
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+#include "../src/list.h"
+#include "../src/server.h"
+#include "../src/trace.h"
+
+#define SOCKET_PATH "bench_server.sock"
+#define DEFAULT_REQUESTS 200000L
+#define DEFAULT_CLIENTS 4
+#define PIPELINE 128
+
+typedef struct {
+    long requests;
+    double seconds;
+    bool ok;
+} Client_t;
+
+static volatile sig_atomic_t stop;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static int connect_server(void) {
+    struct sockaddr_un addr;
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, SOCKET_PATH);
+    if(fd >= 0 && connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static bool read_all(int fd, unsigned char* buf, size_t len) {
+    while(len) {
+        ssize_t n = read(fd, buf, len);
+        if(n <= 0)
+            return false;
+        buf += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+static void* server_thread(void* arg) {
+    Server_Run(arg, &stop);
+    return NULL;
+}
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static bool bench_latency(long requests) {
+    uint64_t* ns = malloc(requests * sizeof(uint64_t));
+    unsigned char op = TRACE_OP_IS_ACTIVE, status;
+    int fd = connect_server();
+    bool ok = fd >= 0 && ns;
+
+    for(long i = 0; i < requests && ok; i++) {
+        uint64_t start = now_ns();
+        ok = write(fd, &op, 1) == 1 && read_all(fd, &status, 1);
+        ns[i] = now_ns() - start;
+    }
+    if(ok) {
+        qsort(ns, requests, sizeof(uint64_t), compare_u64);
+        printf("round trip (Is_Active), %ld requests: p50 %.1f us, p99 %.1f us, "
+               "max %.1f us\n",
+               requests, ns[requests / 2] * 1e-3, ns[requests * 99 / 100] * 1e-3,
+               ns[requests - 1] * 1e-3);
+    }
+    if(fd >= 0)
+        close(fd);
+    free(ns);
+    return ok;
+}
+
+static void* pipelined_client(void* arg) {
+    Client_t* client = arg;
+    Data_t data = {.name = "Bench", .age = 30, .weight = 70, .height = 180};
+    unsigned char req[PIPELINE * (1 + DATA_ENCODED_MAX)];
+    unsigned char resp[PIPELINE];
+    size_t len = 0;
+    uint64_t start;
+    int fd = connect_server();
+
+    client->ok = fd >= 0;
+    for(int i = 0; i < PIPELINE; i++) {
+        req[len++] = TRACE_OP_INSERT_FIRST;
+        len += Data_Encode(&data, req + len);
+    }
+
+    start = now_ns();
+    for(long done = 0; done < client->requests && client->ok; done += PIPELINE) {
+        client->ok = write(fd, req, len) == (ssize_t)len &&
+                     read_all(fd, resp, PIPELINE);
+    }
+    client->seconds = (now_ns() - start) * 1e-9;
+    if(fd >= 0)
+        close(fd);
+    return NULL;
+}
+
+static bool bench_throughput(long requests, int clients) {
+    pthread_t threads[64];
+    Client_t state[64];
+    double seconds = 0;
+    long total = 0;
+    bool ok = true;
+
+    if(clients > 64)
+        clients = 64;
+    for(int i = 0; i < clients; i++) {
+        state[i].requests = requests / clients;
+        pthread_create(&threads[i], NULL, pipelined_client, &state[i]);
+    }
+    for(int i = 0; i < clients; i++) {
+        pthread_join(threads[i], NULL);
+        ok = ok && state[i].ok;
+        total += (state[i].requests + PIPELINE - 1) / PIPELINE * PIPELINE;
+        if(state[i].seconds > seconds)
+            seconds = state[i].seconds;
+    }
+    if(ok)
+        printf("pipelined Insert_First, %d clients x %d in flight: %.0f requests/s\n",
+               clients, PIPELINE, total / seconds);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    long requests = argc > 1 ? atol(argv[1]) : DEFAULT_REQUESTS;
+    int clients = argc > 2 ? atoi(argv[2]) : DEFAULT_CLIENTS;
+    pthread_t thread;
+    Server_t* server;
+    List_t list;
+    bool ok;
+
+    if(requests < 1 || clients < 1) {
+        fprintf(stderr, "Usage: %s [requests] [clients]\n", argv[0]);
+        return 1;
+    }
+
+    List_Init(&list);
+    server = Server_Open(&list, SOCKET_PATH);
+    if(!server) {
+        fprintf(stderr, "Can't listen on %s\n", SOCKET_PATH);
+        return 1;
+    }
+    pthread_create(&thread, NULL, server_thread, server);
+
+    ok = bench_latency(requests) && bench_throughput(requests, clients);
+
+    stop = 1;
+    pthread_join(thread, NULL);
+    Server_Close(server);
+    while(list.first)
+        List_Delete_First(&list);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,192 @@
+/**
+ * @file       aggregate.c
+ * @date       10/2026
+ * @brief      Running count, sum and sum of squares of the numeric fields of
+ * a linear list
+ * ****************************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * Every field keeps the sums of d = x - shift and d^2, each with a Neumaier
+ * compensation term. The variance is then sum(d^2) / n - (sum(d) / n)^2,
+ * where the shift keeps both terms small compared with the variance. When
+ * the last value of a field is removed its sums are reset to exactly zero
+ * and the next value becomes the new shift.
+ */
+
+/* Private includes -------------------------------------------------------- */
+#include "aggregate.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include "list_ext.h"
+#include "order.h"
+
+/* Private types and constants --------------------------------------------- */
+#define AGGREGATE_FIELDS 3
+
+typedef struct {
+    double shift;         /**< first value, subtracted from every value */
+    double sum;           /**< sum of the shifted values */
+    double sumError;      /**< compensation of sum */
+    double squares;       /**< sum of the squared shifted values */
+    double squaresError;  /**< compensation of squares */
+    size_t count;         /**< finite values */
+} Aggregate_Field_t;
+
+struct List_Aggregate_s {
+    Aggregate_Field_t fields[AGGREGATE_FIELDS]; /**< age, weight and height */
+    size_t items;                               /**< items of the list */
+};
+
+/* Private functions ------------------------------------------------------- */
+
+/** Adds value to sum, accumulating the lost low bits in error */
+static void neumaier_add(double* sum, double* error, double value) {
+    double total = *sum + value;
+
+    if(fabs(*sum) >= fabs(value))
+        *error += (*sum - total) + value;
+    else
+        *error += (value - total) + *sum;
+    *sum = total;
+}
+
+static void field_update(Aggregate_Field_t* field, double value, int sign) {
+    double shifted;
+
+    if(!isfinite(value))
+        return;
+    if(sign < 0) {
+        if(!field->count)
+            return;
+        if(!--field->count) {
+            field->sum = field->sumError = 0;
+            field->squares = field->squaresError = 0;
+            return;
+        }
+    } else if(!field->count++) {
+        field->shift = value;
+    }
+    shifted = value - field->shift;
+    neumaier_add(&field->sum, &field->sumError, sign * shifted);
+    neumaier_add(&field->squares, &field->squaresError, sign * shifted * shifted);
+}
+
+static double field_of(const Data_t* data, int field) {
+    switch(field) {
+    case 0:
+        return data->age;
+    case 1:
+        return data->weight;
+    default:
+        return data->height;
+    }
+}
+
+/** Returns the index of a numeric field in List_Aggregate_s, -1 for others */
+static int field_index(Data_Field_t field) {
+    switch(field) {
+    case DATA_FIELD_AGE:
+        return 0;
+    case DATA_FIELD_WEIGHT:
+        return 1;
+    case DATA_FIELD_HEIGHT:
+        return 2;
+    default:
+        return -1;
+    }
+}
+
+/** Returns the aggregated field, from a traversal into scratch if needed */
+static const Aggregate_Field_t* field_of_list(List_t list, Data_Field_t field,
+                                             List_Aggregate_t* scratch) {
+    int index = field_index(field);
+
+    if(index < 0)
+        return NULL;
+    if(list.ext && list.ext->aggregate)
+        return &list.ext->aggregate->fields[index];
+    scratch->fields[index] = (Aggregate_Field_t){0, 0, 0, 0, 0, 0};
+    for(const List_Node_t* node = list.first; node; node = node->next)
+        field_update(&scratch->fields[index], field_of(&node->data, index), 1);
+    return &scratch->fields[index];
+}
+
+/* Functions definitions --------------------------------------------------- */
+
+bool List_Aggregate_Attach(List_t* const list) {
+    List_Ext_t* ext;
+    List_Aggregate_t* aggregate;
+
+    if(!list || (list->ext && list->ext->aggregate))
+        return false;
+    aggregate = calloc(1, sizeof(*aggregate));
+    ext = aggregate ? List_Ext_Get(list) : NULL;
+    if(!ext) {
+        free(aggregate);
+        return false;
+    }
+    for(const List_Node_t* node = list->first; node; node = node->next)
+        List_Aggregate_Add(aggregate, &node->data);
+    ext->aggregate = aggregate;
+    return true;
+}
+
+void List_Aggregate_Detach(List_t* const list) {
+    if(!list || !list->ext || !list->ext->aggregate)
+        return;
+    free(list->ext->aggregate);
+    list->ext->aggregate = NULL;
+    List_Ext_Release(list);
+}
+
+size_t List_Count(List_t list) {
+    if(list.ext && list.ext->aggregate)
+        return list.ext->aggregate->items;
+    return List_Length(list);
+}
+
+bool List_Sum(List_t list, Data_Field_t field, double* sum) {
+    List_Aggregate_t scratch;
+    const Aggregate_Field_t* f = field_of_list(list, field, &scratch);
+
+    if(!f || !sum)
+        return false;
+    *sum = f->count * f->shift + (f->sum + f->sumError);
+    return true;
+}
+
+bool List_Mean(List_t list, Data_Field_t field, double* mean) {
+    List_Aggregate_t scratch;
+    const Aggregate_Field_t* f = field_of_list(list, field, &scratch);
+
+    if(!f || !mean || !f->count)
+        return false;
+    *mean = f->shift + (f->sum + f->sumError) / f->count;
+    return true;
+}
+
+bool List_Stddev(List_t list, Data_Field_t field, double* stddev) {
+    List_Aggregate_t scratch;
+    const Aggregate_Field_t* f = field_of_list(list, field, &scratch);
+    double mean, variance;
+
+    if(!f || !stddev || !f->count)
+        return false;
+    mean = (f->sum + f->sumError) / f->count;
+    variance = (f->squares + f->squaresError) / f->count - mean * mean;
+    *stddev = variance > 0 ? sqrt(variance) : 0;
+    return true;
+}
+
+void List_Aggregate_Add(List_Aggregate_t* aggregate, const Data_t* data) {
+    aggregate->items++;
+    for(int i = 0; i < AGGREGATE_FIELDS; i++)
+        field_update(&aggregate->fields[i], field_of(data, i), 1);
+}
+
+void List_Aggregate_Remove(List_Aggregate_t* aggregate, const Data_t* data) {
+    aggregate->items--;
+    for(int i = 0; i < AGGREGATE_FIELDS; i++)
+        field_update(&aggregate->fields[i], field_of(data, i), -1);
+}
@@ -0,0 +1,82 @@
+/**
+ * @file       aggregate.h
+ * @date       10/2026
+ * @brief      Running count, sum and sum of squares of the numeric fields of
+ * a linear list
+ * **********************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * With aggregates attached, every insert, delete and List_Actualize adds or
+ * subtracts the age, weight and height of the item, so List_Count,
+ * List_Sum, List_Mean and List_Stddev answer in O(1). The sums are
+ * compensated (Neumaier) and taken around a shift, the first value of the
+ * field, so neither a long run of updates nor values with a large mean and
+ * a small spread make them drift. Without aggregates the same calls
+ * traverse the list.
+ */
+
+#ifndef AGGREGATE_H
+#define AGGREGATE_H
+
+/* Public includes --------------------------------------------------------- */
+#include <stdbool.h>
+#include <stddef.h>
+#include "data.h"
+#include "list.h"
+
+/* Public aggregate API ---------------------------------------------------- */
+/**
+ * @brief Sums the fields of the current items and attaches the aggregates
+ * to the list. List_Free releases them.
+ * @param list[in] - list, whose fields should be aggregated
+ * @return Returns false when out of memory or if aggregates are already
+ * attached
+ */
+bool List_Aggregate_Attach(List_t* const list);
+
+/**
+ * @brief Releases the aggregates of the list, if any
+ * @param list[in] - list, whose aggregates should be released
+ */
+void List_Aggregate_Detach(List_t* const list);
+
+/**
+ * @brief Returns the number of items in the list
+ */
+size_t List_Count(List_t list);
+
+/**
+ * @brief Returns the sum of a numeric field over the items, NaN and
+ * infinite values are left out of all aggregates
+ * @param list[in] - list, whose items are summed
+ * @param field[in] - numeric field (not DATA_FIELD_NAME)
+ * @param sum[out] - the sum, 0 for an empty list
+ * @return Returns false for an invalid argument
+ */
+bool List_Sum(List_t list, Data_Field_t field, double* sum);
+
+/**
+ * @brief Returns the mean of a numeric field over the items
+ * @return Returns false for an invalid argument or if there is no value
+ */
+bool List_Mean(List_t list, Data_Field_t field, double* mean);
+
+/**
+ * @brief Returns the population standard deviation (divided by n) of a
+ * numeric field over the items
+ * @return Returns false for an invalid argument or if there is no value
+ */
+bool List_Stddev(List_t list, Data_Field_t field, double* stddev);
+
+/* Aggregate maintenance, called by list.c --------------------------------- */
+/**
+ * @brief Adds the fields of an item
+ */
+void List_Aggregate_Add(List_Aggregate_t* aggregate, const Data_t* data);
+
+/**
+ * @brief Subtracts the fields of an item added before
+ */
+void List_Aggregate_Remove(List_Aggregate_t* aggregate, const Data_t* data);
+
+#endif /* AGGREGATE_H */
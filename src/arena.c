@@ -0,0 +1,201 @@
+/**
+ * @file       arena.c
+ * @date       10/2026
+ * @brief      Node arena of a linear list backed by (huge) pages from mmap
+ * ****************************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * The whole capacity is reserved at once as PROT_NONE, which costs address
+ * space only, and aligned to 2 MiB so that huge pages can back it from the
+ * first byte. Committing it step by step with mprotect keeps the memory
+ * accounting honest even with strict overcommit. Items are handed out by
+ * bumping a pointer; released ones are chained through their next pointer
+ * and reused first. Ownership of an item is a range check.
+ */
+
+#define _DEFAULT_SOURCE
+
+#if !defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 200809L
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+/* Private includes -------------------------------------------------------- */
+#include "arena.h"
+
+#include <stdlib.h>
+
+#ifdef __linux__
+
+#include <stdint.h>
+#include <sys/mman.h>
+#include "list_ext.h"
+
+/* Private types and constants --------------------------------------------- */
+#define ARENA_HUGE_PAGE ((size_t)2 << 20)
+/** Memory committed at once, a multiple of ARENA_HUGE_PAGE */
+#define ARENA_COMMIT_STEP ((size_t)32 << 20)
+#define ARENA_DEFAULT_ITEMS ((size_t)1 << 25)
+
+struct List_Arena_s {
+    unsigned char* base;  /**< start of the reserved region */
+    size_t reserved;      /**< bytes of address space */
+    size_t limit;         /**< bytes of maxItems items */
+    size_t committed;     /**< bytes readable and writable from base */
+    size_t used;          /**< bytes handed out from base */
+    List_Node_t* free;    /**< released items, chained through next */
+    size_t live;          /**< items in use */
+    bool huge;            /**< MADV_HUGEPAGE was accepted */
+};
+
+/* Private functions ------------------------------------------------------- */
+
+static size_t round_up(size_t value, size_t step) {
+    return (value + step - 1) / step * step;
+}
+
+/** Reserves size bytes of address space aligned to a huge page */
+static unsigned char* reserve(size_t size) {
+    size_t mapped = size + ARENA_HUGE_PAGE;
+    unsigned char* map = mmap(NULL, mapped, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    unsigned char* base;
+
+    if(map == MAP_FAILED)
+        return NULL;
+    base = (unsigned char*)round_up((uintptr_t)map, ARENA_HUGE_PAGE);
+    if(base > map)
+        munmap(map, (size_t)(base - map));
+    if(map + mapped > base + size)
+        munmap(base + size, (size_t)(map + mapped - (base + size)));
+    return base;
+}
+
+/* Functions definitions --------------------------------------------------- */
+
+bool List_Arena_Attach(List_t* const list, size_t maxItems, bool hugePages) {
+    List_Ext_t* ext;
+    List_Arena_t* arena;
+
+    if(!list || (list->ext && list->ext->arena))
+        return false;
+    if(!maxItems)
+        maxItems = ARENA_DEFAULT_ITEMS;
+    if(maxItems > SIZE_MAX / 2 / sizeof(List_Node_t))
+        return false;
+
+    arena = calloc(1, sizeof(*arena));
+    if(!arena)
+        return false;
+    arena->limit = maxItems * sizeof(List_Node_t);
+    arena->reserved = round_up(arena->limit, ARENA_HUGE_PAGE);
+    arena->base = reserve(arena->reserved);
+    if(!arena->base) {
+        free(arena);
+        return false;
+    }
+#if defined(MADV_HUGEPAGE) && defined(MADV_NOHUGEPAGE)
+    if(hugePages)
+        arena->huge = madvise(arena->base, arena->reserved, MADV_HUGEPAGE) == 0;
+    else
+        madvise(arena->base, arena->reserved, MADV_NOHUGEPAGE);
+#else
+    (void)hugePages;
+#endif
+
+    ext = List_Ext_Get(list);
+    if(!ext) {
+        munmap(arena->base, arena->reserved);
+        free(arena);
+        return false;
+    }
+    ext->arena = arena;
+    return true;
+}
+
+bool List_Arena_Detach(List_t* const list) {
+    List_Arena_t* arena = list && list->ext ? list->ext->arena : NULL;
+
+    if(!arena)
+        return true;
+    if(arena->live)
+        return false;
+
+    munmap(arena->base, arena->reserved);
+    free(arena);
+    list->ext->arena = NULL;
+    List_Ext_Release(list);
+    return true;
+}
+
+bool List_Arena_Huge_Pages(List_t list) {
+    return list.ext && list.ext->arena && list.ext->arena->huge;
+}
+
+List_Node_t* List_Arena_Alloc(List_Arena_t* arena) {
+    List_Node_t* node = arena->free;
+
+    if(node) {
+        arena->free = node->next;
+        arena->live++;
+        return node;
+    }
+
+    if(arena->used + sizeof(List_Node_t) > arena->limit)
+        return NULL;
+    if(arena->used + sizeof(List_Node_t) > arena->committed) {
+        size_t step = arena->reserved - arena->committed;
+
+        if(step > ARENA_COMMIT_STEP)
+            step = ARENA_COMMIT_STEP;
+        if(mprotect(arena->base + arena->committed, step, PROT_READ | PROT_WRITE) != 0)
+            return NULL;
+        arena->committed += step;
+    }
+    node = (List_Node_t*)(arena->base + arena->used);
+    arena->used += sizeof(List_Node_t);
+    arena->live++;
+    return node;
+}
+
+bool List_Arena_Free(List_Arena_t* arena, List_Node_t* node) {
+    uintptr_t p = (uintptr_t)node;
+
+    if(p < (uintptr_t)arena->base || p >= (uintptr_t)arena->base + arena->used)
+        return false;
+    node->next = arena->free;
+    arena->free = node;
+    arena->live--;
+    return true;
+}
+
+#else /* !__linux__ */
+
+bool List_Arena_Attach(List_t* const list, size_t maxItems, bool hugePages) {
+    (void)list;
+    (void)maxItems;
+    (void)hugePages;
+    return false;
+}
+
+bool List_Arena_Detach(List_t* const list) {
+    (void)list;
+    return true;
+}
+
+bool List_Arena_Huge_Pages(List_t list) {
+    (void)list;
+    return false;
+}
+
+List_Node_t* List_Arena_Alloc(List_Arena_t* arena) {
+    (void)arena;
+    return NULL;
+}
+
+bool List_Arena_Free(List_Arena_t* arena, List_Node_t* node) {
+    (void)arena;
+    (void)node;
+    return false;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,70 @@
+/**
+ * @file       arena.h
+ * @date       10/2026
+ * @brief      Node arena of a linear list backed by (huge) pages from mmap
+ * **********************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * With an arena attached, List_Node_Alloc places new items side by side in
+ * one reserved region of virtual memory instead of calling myMalloc, and
+ * List_Node_Free puts them on a free list of the arena. The region is
+ * advised as MADV_HUGEPAGE, so traversals touch a few 2 MiB pages instead
+ * of thousands of 4 KiB ones and miss the TLB far less often. Where
+ * transparent huge pages are unavailable the arena still works with normal
+ * pages. Items allocated before the arena was attached, or after it is
+ * full, come from myMalloc as before and are released there.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+/* Public includes --------------------------------------------------------- */
+#include <stdbool.h>
+#include <stddef.h>
+#include "list.h"
+
+/* Public arena API -------------------------------------------------------- */
+/**
+ * @brief Reserves address space for maxItems items and attaches the arena
+ * to the list. Memory is committed in 32 MiB steps as items are allocated.
+ * List_Free releases the arena. Only available on Linux.
+ * @param list[in] - list, whose items should be placed in the arena
+ * @param maxItems[in] - capacity of the arena, 0 for 2^25 items (9 GiB of
+ * address space)
+ * @param hugePages[in] - advise the region as MADV_HUGEPAGE, otherwise as
+ * MADV_NOHUGEPAGE
+ * @return Returns false if an arena is already attached or the address
+ * space can not be reserved
+ */
+bool List_Arena_Attach(List_t* const list, size_t maxItems, bool hugePages);
+
+/**
+ * @brief Unmaps the arena of the list. Fails while any item of the arena is
+ * still in use, including dead items of the lazy delete mode.
+ * @param list[in] - list, whose arena should be released
+ * @return Returns false if items of the arena are still in use
+ */
+bool List_Arena_Detach(List_t* const list);
+
+/**
+ * @brief Tells whether the kernel accepted the huge page advice
+ * @param list[in] - list, whose arena is queried
+ * @return Returns false if no arena is attached, it was attached without
+ * huge pages or transparent huge pages are unavailable
+ */
+bool List_Arena_Huge_Pages(List_t list);
+
+/* Arena allocation, called by list.c -------------------------------------- */
+/**
+ * @brief Takes an item from the arena
+ * @return Returns NULL when the arena is full
+ */
+List_Node_t* List_Arena_Alloc(List_Arena_t* arena);
+
+/**
+ * @brief Returns an item to the arena
+ * @return Returns false if the item does not belong to the arena
+ */
+bool List_Arena_Free(List_Arena_t* arena, List_Node_t* node);
+
+#endif /* ARENA_H */
@@ -0,0 +1,155 @@
+/**
+ * @file       bloom.c
+ * @date       10/2026
+ * @brief      Counting Bloom filter of the names in a linear list
+ * ****************************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * A name is hashed once into 64 bits; the k probe positions are derived
+ * from its two halves by double hashing and mapped onto the counter array
+ * by a multiply-shift instead of a division. Counters are 4 bits, two per
+ * byte. A counter that reaches 15 stays there, so an overflow can cost
+ * false positives but never a false negative.
+ */
+
+/* Private includes -------------------------------------------------------- */
+#include "bloom.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "list_ext.h"
+
+/* Private types and constants --------------------------------------------- */
+#define BLOOM_MIN_COUNTERS 64u
+#define BLOOM_MAX_COUNTERS UINT32_MAX
+#define BLOOM_MAX_HASHES 16u
+#define BLOOM_SATURATED 15u
+/** 1 / ln 2 */
+#define BLOOM_LOG2E 1.4426950408889634
+
+struct List_Bloom_s {
+    uint8_t* counters; /**< 4-bit counters, two per byte */
+    uint32_t count;    /**< number of counters */
+    uint32_t hashes;   /**< probes per name */
+};
+
+/* Private functions ------------------------------------------------------- */
+
+static uint64_t hash_name(const char* name) {
+    uint64_t h = UINT64_C(0xCBF29CE484222325);
+
+    for(size_t i = 0; i < sizeof(((Data_t*)0)->name) && name[i]; i++) {
+        h ^= (unsigned char)name[i];
+        h *= UINT64_C(0x100000001B3);
+    }
+    /* FNV-1a mixes the last bytes poorly, finish it like MurmurHash3 */
+    h ^= h >> 33;
+    h *= UINT64_C(0xFF51AFD7ED558CCD);
+    h ^= h >> 33;
+    h *= UINT64_C(0xC4CEB9FE1A85EC53);
+    h ^= h >> 33;
+    return h;
+}
+
+static uint32_t probe(const List_Bloom_t* bloom, uint64_t h, uint32_t i) {
+    uint32_t g = (uint32_t)h + i * ((uint32_t)(h >> 32) | 1u);
+    return (uint32_t)(((uint64_t)g * bloom->count) >> 32);
+}
+
+static unsigned counter_get(const List_Bloom_t* bloom, uint32_t index) {
+    return (bloom->counters[index >> 1] >> ((index & 1) * 4)) & 0xFu;
+}
+
+static void counter_add(List_Bloom_t* bloom, uint32_t index, int delta) {
+    unsigned shift = (index & 1) * 4;
+    unsigned value = counter_get(bloom, index);
+
+    if(value == BLOOM_SATURATED || (delta < 0 && value == 0))
+        return;
+    value = (unsigned)((int)value + delta);
+    bloom->counters[index >> 1] =
+        (uint8_t)((bloom->counters[index >> 1] & ~(0xFu << shift)) | (value << shift));
+}
+
+static void update(List_Bloom_t* bloom, const char* name, int delta) {
+    uint64_t h = hash_name(name);
+
+    for(uint32_t i = 0; i < bloom->hashes; i++)
+        counter_add(bloom, probe(bloom, h, i), delta);
+}
+
+/* Functions definitions --------------------------------------------------- */
+
+bool List_Bloom_Attach(List_t* const list, size_t expected, double rate) {
+    List_Ext_t* ext;
+    List_Bloom_t* bloom;
+    uint32_t hashes = 0;
+    double counters;
+
+    if(!list || (list->ext && list->ext->bloom) || !expected || !(rate > 0 && rate < 1))
+        return false;
+
+    /* k = log2(1 / rate) probes rounded up and k / ln 2 counters per item,
+     * the optimum for which the rate is 2^-k */
+    for(double p = 1; p > rate && hashes < BLOOM_MAX_HASHES; p /= 2)
+        hashes++;
+    counters = (double)expected * hashes * BLOOM_LOG2E;
+    if(counters > BLOOM_MAX_COUNTERS)
+        return false;
+
+    bloom = malloc(sizeof(*bloom));
+    if(!bloom)
+        return false;
+    bloom->count = counters < BLOOM_MIN_COUNTERS ? BLOOM_MIN_COUNTERS : (uint32_t)counters;
+    bloom->hashes = hashes;
+    bloom->counters = calloc(((size_t)bloom->count + 1) / 2, 1);
+    if(!bloom->counters) {
+        free(bloom);
+        return false;
+    }
+
+    ext = List_Ext_Get(list);
+    if(!ext) {
+        free(bloom->counters);
+        free(bloom);
+        return false;
+    }
+    for(const List_Node_t* node = list->first; node; node = node->next)
+        update(bloom, node->data.name, 1);
+    ext->bloom = bloom;
+    return true;
+}
+
+void List_Bloom_Detach(List_t* const list) {
+    if(!list || !list->ext || !list->ext->bloom)
+        return;
+    free(list->ext->bloom->counters);
+    free(list->ext->bloom);
+    list->ext->bloom = NULL;
+    List_Ext_Release(list);
+}
+
+bool List_Maybe_Contains_Name(List_t list, const char* name) {
+    List_Bloom_t* bloom = list.ext ? list.ext->bloom : NULL;
+    uint64_t h;
+
+    if(!name)
+        return false;
+    if(!bloom)
+        return true;
+
+    h = hash_name(name);
+    for(uint32_t i = 0; i < bloom->hashes; i++) {
+        if(!counter_get(bloom, probe(bloom, h, i)))
+            return false;
+    }
+    return true;
+}
+
+void List_Bloom_Add(List_Bloom_t* bloom, const char* name) {
+    update(bloom, name, 1);
+}
+
+void List_Bloom_Remove(List_Bloom_t* bloom, const char* name) {
+    update(bloom, name, -1);
+}
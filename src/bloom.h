@@ -0,0 +1,67 @@
+/**
+ * @file       bloom.h
+ * @date       10/2026
+ * @brief      Counting Bloom filter of the names in a linear list
+ * **********************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * The filter is attached to a list at run time and kept up to date by
+ * every insert, delete and List_Actualize. It answers whether a name may
+ * be in the list with a few probes of a counter array: "no" is always
+ * right, "maybe" is wrong with the configured false positive rate while
+ * the list holds at most the expected number of items. Names must only be
+ * changed by List_Actualize while a filter is attached.
+ */
+
+#ifndef BLOOM_H
+#define BLOOM_H
+
+/* Public includes --------------------------------------------------------- */
+#include <stdbool.h>
+#include <stddef.h>
+#include "list.h"
+
+/* Public Bloom filter API ------------------------------------------------- */
+/**
+ * @brief Sizes a counting Bloom filter for the expected number of items
+ * and false positive rate, adds the names of the current items and
+ * attaches it to the list. The filter probes k = log2(1 / rate) (rounded
+ * up, at most 16) 4-bit counters per name and keeps k / ln 2 counters per
+ * expected item, that is 0.72 * k bytes (5 B at 1 %, 7.2 B at 0.1 %).
+ * List_Free releases the filter.
+ * @param list[in] - list, whose names should be filtered
+ * @param expected[in] - number of items the filter is sized for
+ * @param rate[in] - false positive rate at the expected number of items,
+ * between 0 and 1
+ * @return Returns false on invalid parameters, when out of memory or if a
+ * filter is already attached
+ */
+bool List_Bloom_Attach(List_t* const list, size_t expected, double rate);
+
+/**
+ * @brief Releases the filter of the list, if any
+ * @param list[in] - list, whose filter should be released
+ */
+void List_Bloom_Detach(List_t* const list);
+
+/**
+ * @brief Checks whether an item with the name may be in the list
+ * @param list[in] - searched list
+ * @param name[in] - name to look for
+ * @return Returns false only if no item has the name; always true when no
+ * filter is attached
+ */
+bool List_Maybe_Contains_Name(List_t list, const char* name);
+
+/* Filter maintenance, called by list.c ------------------------------------ */
+/**
+ * @brief Counts one more item with the name
+ */
+void List_Bloom_Add(List_Bloom_t* bloom, const char* name);
+
+/**
+ * @brief Counts one item with the name less, the name must have been added
+ */
+void List_Bloom_Remove(List_Bloom_t* bloom, const char* name);
+
+#endif /* BLOOM_H */
@@ -0,0 +1,479 @@
+/**
+ * \file    csvio.c
+ * \date    10/2026
+ * \brief   Streaming CSV/TSV import and export of records
+ */
+
+#if !defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 200809L
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "csvio.h"
+#include "ioutils.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+/** Result of parsing the buffered data. */
+#define CSV_NEED_MORE 0
+#define CSV_ERROR -1
+
+/**
+ * @brief   Parses the name field, quoted or not.
+ * @return  Pointer behind the field, NULL if more data is needed,
+ *          end + 1 if the field is malformed.
+ */
+static const char *parse_name(const char *p, const char *end, char sep,
+                              char *name, size_t maxLen) {
+  size_t len = 0;
+
+  if (p < end && *p == '"') {
+    p++;
+
+    for (;;) {
+      if (p >= end) {
+        return NULL;
+      }
+
+      if (*p == '"') {
+        if (p + 1 >= end) {
+          return NULL;
+        }
+
+        if (p[1] != '"') {
+          p++;
+          break;
+        }
+
+        p++; /* doubled quote */
+      }
+
+      if (len < maxLen) {
+        name[len++] = *p;
+      }
+
+      p++;
+    }
+  } else {
+    while (p < end && *p != sep && *p != '\n' && *p != '\r') {
+      if (len < maxLen) {
+        name[len++] = *p;
+      }
+
+      p++;
+    }
+
+    if (p >= end) {
+      return NULL;
+    }
+  }
+
+  name[len] = 0;
+
+  if (p >= end) {
+    return NULL;
+  }
+
+  return *p == sep ? p + 1 : end + 1;
+}
+
+/**
+ * @brief   Parses a numeric field ending with terminator.
+ * @return  Pointer behind the terminator, NULL if more data is needed,
+ *          end + 1 if the field is malformed.
+ */
+static const char *parse_number(const char *p, const char *end, char terminator,
+                                double *val) {
+  const char *stop = memchr(p, terminator, (size_t)(end - p));
+  const char *next;
+
+  if (stop == NULL) {
+    return NULL;
+  }
+
+  if (!io_utils_parse_double(p, stop, val, &next)) {
+    return end + 1;
+  }
+
+  while (next < stop && (*next == ' ' || *next == '\t' || *next == '\r')) {
+    next++;
+  }
+
+  return next == stop ? stop + 1 : end + 1;
+}
+
+/**
+ * @brief   Parses one record from [p, end). At the end of input a missing
+ *          final line break is supplied by the caller through atEof.
+ * @return  Length of the record, CSV_NEED_MORE or CSV_ERROR.
+ */
+static long parse_record(const char *p, const char *end, char sep, bool atEof,
+                         Data_t *data) {
+  const char *q = parse_name(p, end, sep, data->name, sizeof(data->name) - 1);
+
+  if (q == NULL) {
+    return atEof && p < end ? CSV_ERROR : CSV_NEED_MORE;
+  }
+
+  if (q > end) {
+    return CSV_ERROR;
+  }
+
+  if ((q = parse_number(q, end, sep, &data->age)) == NULL ||
+      q > end ||
+      (q = parse_number(q, end, sep, &data->weight)) == NULL || q > end) {
+    return q == NULL && !atEof ? CSV_NEED_MORE : CSV_ERROR;
+  }
+
+  {
+    const char *last = parse_number(q, end, '\n', &data->height);
+
+    if (last == NULL && atEof) {
+      /* last line without line break */
+      const char *next;
+
+      if (!io_utils_parse_double(q, end, &data->height, &next)) {
+        return CSV_ERROR;
+      }
+
+      while (next < end && (*next == ' ' || *next == '\t' || *next == '\r')) {
+        next++;
+      }
+
+      return next == end ? (long)(end - p) : CSV_ERROR;
+    }
+
+    if (last == NULL) {
+      return CSV_NEED_MORE;
+    }
+
+    return last > end ? CSV_ERROR : (long)(last - p);
+  }
+}
+
+/**
+ * @brief   Moves unparsed data to the start of the buffer and reads more.
+ * @return  False on read error or when a record does not fit in the buffer.
+ */
+static bool reader_fill(csv_reader_t *reader) {
+  ssize_t n;
+
+  if (reader->start > 0) {
+    memmove(reader->buffer, reader->buffer + reader->start,
+            reader->end - reader->start);
+    reader->end -= reader->start;
+    reader->start = 0;
+  }
+
+  if (reader->end == reader->size) {
+    return false;
+  }
+
+  do {
+    n = read(reader->fd, reader->buffer + reader->end,
+             reader->size - reader->end);
+  } while (n < 0 && errno == EINTR);
+
+  if (n < 0) {
+    return false;
+  }
+
+  if (n == 0) {
+    reader->eof = true;
+  }
+
+  reader->end += (size_t)n;
+  return true;
+}
+
+/**
+ * @brief   Prepares a reader over descriptor fd.
+ * @param   buffer  Buffer for the input, longest record has to fit in it.
+ */
+void csv_reader_init(csv_reader_t *reader, int fd, char *buffer, size_t size,
+                     char sep) {
+  memset(reader, 0, sizeof(*reader));
+  reader->fd = fd;
+  reader->buffer = buffer;
+  reader->size = size;
+  reader->sep = sep;
+  reader->line = 1;
+}
+
+/**
+ * @brief   Reads one record. Empty lines are skipped.
+ * @return  1 if a record was read, 0 at the end of input, -1 if the input is
+ *          malformed, can't be read or a record is longer than the buffer.
+ */
+int csv_read_record(csv_reader_t *reader, Data_t *data) {
+  for (;;) {
+    const char *p = reader->buffer + reader->start;
+    const char *end = reader->buffer + reader->end;
+    long len;
+
+    while (p < end && (*p == '\n' || *p == '\r')) {
+      reader->line += (*p == '\n');
+      p++;
+    }
+
+    reader->start = (size_t)(p - reader->buffer);
+
+    if (p == end && reader->eof) {
+      return 0;
+    }
+
+    len = parse_record(p, end, reader->sep, reader->eof, data);
+
+    if (len == CSV_ERROR) {
+      return -1;
+    }
+
+    if (len > 0) {
+      reader->start += (size_t)len;
+      reader->line++;
+      return 1;
+    }
+
+    if (!reader_fill(reader)) {
+      return -1;
+    }
+  }
+}
+
+/**
+ * @brief   Skips one line of input, e.g. a header.
+ * @return  False if there was no line to skip.
+ */
+bool csv_skip_line(csv_reader_t *reader) {
+  for (;;) {
+    const char *p = reader->buffer + reader->start;
+    const char *nl = memchr(p, '\n', reader->end - reader->start);
+
+    if (nl != NULL) {
+      reader->start = (size_t)(nl + 1 - reader->buffer);
+      reader->line++;
+      return true;
+    }
+
+    if (reader->eof) {
+      bool any = reader->start < reader->end;
+      reader->start = reader->end;
+      return any;
+    }
+
+    /* the line doesn't have to fit in the buffer, drop what we have */
+    reader->start = reader->end;
+
+    if (!reader_fill(reader)) {
+      return false;
+    }
+  }
+}
+
+/**
+ * @brief   Prepares a writer over descriptor fd.
+ * @param   size    Size of the buffer, at least #CSV_RECORD_MAX bytes.
+ */
+void csv_writer_init(csv_writer_t *writer, int fd, char *buffer, size_t size,
+                     char sep) {
+  memset(writer, 0, sizeof(*writer));
+  writer->fd = fd;
+  writer->buffer = buffer;
+  writer->size = size;
+  writer->sep = sep;
+  writer->ok = buffer != NULL && size >= CSV_RECORD_MAX;
+}
+
+/**
+ * @brief   Writes all buffered data with as few write() calls as possible.
+ */
+bool csv_writer_flush(csv_writer_t *writer) {
+  const char *p = writer->buffer;
+
+  while (writer->ok && writer->used > 0) {
+    ssize_t n = write(writer->fd, p, writer->used);
+
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+
+    if (n <= 0) {
+      writer->ok = false;
+      break;
+    }
+
+    p += n;
+    writer->used -= (size_t)n;
+  }
+
+  writer->used = 0;
+  return writer->ok;
+}
+
+/**
+ * @brief   Prints the shortest of %.15g and %.17g that reads back exactly.
+ */
+static int format_double(char *out, double val) {
+  int len = sprintf(out, "%.15g", val);
+  double back;
+
+  if (!io_utils_parse_double(out, out + len, &back, NULL) || back != val) {
+    len = sprintf(out, "%.17g", val);
+  }
+
+  return len;
+}
+
+static bool writer_reserve(csv_writer_t *writer) {
+  if (writer->size - writer->used < CSV_RECORD_MAX) {
+    return csv_writer_flush(writer);
+  }
+
+  return writer->ok;
+}
+
+/**
+ * @brief   Appends one record, the buffer is written out only when full.
+ */
+bool csv_write_record(csv_writer_t *writer, const Data_t *data) {
+  char *out;
+  size_t nameLen;
+  bool quote = false;
+
+  if (!writer_reserve(writer)) {
+    return false;
+  }
+
+  out = writer->buffer + writer->used;
+  nameLen = strlen(data->name);
+
+  if (nameLen > 0 &&
+      (data->name[0] == ' ' || data->name[nameLen - 1] == ' ')) {
+    quote = true;
+  }
+
+  for (size_t i = 0; i < nameLen && !quote; i++) {
+    char c = data->name[i];
+    quote = c == writer->sep || c == '"' || c == '\n' || c == '\r';
+  }
+
+  if (quote) {
+    *out++ = '"';
+
+    for (size_t i = 0; i < nameLen; i++) {
+      if (data->name[i] == '"') {
+        *out++ = '"';
+      }
+
+      *out++ = data->name[i];
+    }
+
+    *out++ = '"';
+  } else {
+    memcpy(out, data->name, nameLen);
+    out += nameLen;
+  }
+
+  *out++ = writer->sep;
+  out += format_double(out, data->age);
+  *out++ = writer->sep;
+  out += format_double(out, data->weight);
+  *out++ = writer->sep;
+  out += format_double(out, data->height);
+  *out++ = '\n';
+  writer->used = (size_t)(out - writer->buffer);
+  return true;
+}
+
+bool csv_write_header(csv_writer_t *writer) {
+  if (!writer_reserve(writer)) {
+    return false;
+  }
+
+  writer->used += sprintf(writer->buffer + writer->used,
+                          "name%cage%cweight%cheight\n", writer->sep,
+                          writer->sep, writer->sep);
+  return true;
+}
+
+/**
+ * @brief   Reads all records from fd and puts them at the start of the list
+ *          in the order of the input, active item stays the same.
+ * @param   header  The first line is a header and is skipped.
+ * @param   count   If not NULL, receives number of imported records.
+ * @return  False if the input is malformed or an item can't be allocated,
+ *          records imported before the error stay in the list.
+ */
+bool List_Import_Csv(List_t *const list, int fd, char *buffer, size_t size,
+                     char sep, bool header, size_t *count) {
+  csv_reader_t reader;
+  List_Node_t *last = NULL;
+  size_t imported = 0;
+  int result = 0;
+
+  if (count) {
+    *count = 0;
+  }
+
+  if (list == NULL || buffer == NULL || size == 0) {
+    return false;
+  }
+
+  csv_reader_init(&reader, fd, buffer, size, sep);
+
+  if (header) {
+    csv_skip_line(&reader);
+  }
+
+  for (;;) {
+    List_Node_t *node = List_Node_Alloc(list);
+
+    if (node == NULL) {
+      result = -1;
+      break;
+    }
+
+    result = csv_read_record(&reader, &node->data);
+
+    if (result != 1) {
+      List_Node_Free(list, node);
+      break;
+    }
+
+    List_Link_After(list, last, node);
+    last = node;
+    imported++;
+  }
+
+  if (count) {
+    *count = imported;
+  }
+
+  return result == 0;
+}
+
+/**
+ * @brief   Writes all items of the list to fd.
+ */
+bool List_Export_Csv(const List_t *const list, int fd, char *buffer,
+                     size_t size, char sep, bool header) {
+  csv_writer_t writer;
+
+  if (list == NULL) {
+    return false;
+  }
+
+  csv_writer_init(&writer, fd, buffer, size, sep);
+
+  if (header) {
+    csv_write_header(&writer);
+  }
+
+  for (List_Node_t *node = list->first; node && writer.ok; node = node->next) {
+    csv_write_record(&writer, &node->data);
+  }
+
+  return csv_writer_flush(&writer);
+}
@@ -0,0 +1,60 @@
+/**
+ * \file    csvio.h
+ * \date    10/2026
+ * \brief   Streaming CSV/TSV import and export of records
+ *
+ * Records are one per line: name, age, weight and height separated by the
+ * chosen separator (',' for CSV, '\t' for TSV). Names containing the
+ * separator, quotes or line breaks are quoted, quotes inside are doubled.
+ * Reader and writer work over a file descriptor and a buffer supplied by the
+ * caller and never hold more than that one buffer of data.
+ */
+
+#ifndef CSVIO_H_
+#define CSVIO_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "data.h"
+#include "list.h"
+
+/** Longest line csv_write_record can produce, smallest usable buffer size. */
+#define CSV_RECORD_MAX 640
+
+typedef struct {
+  int fd;       /**< descriptor the records are read from */
+  char *buffer; /**< buffer owned by the caller */
+  size_t size;  /**< size of the buffer */
+  size_t start; /**< first unparsed byte */
+  size_t end;   /**< end of valid data */
+  char sep;     /**< field separator */
+  bool eof;     /**< no more data in fd */
+  long line;    /**< current line, for error reporting */
+} csv_reader_t;
+
+typedef struct {
+  int fd;       /**< descriptor the records are written to */
+  char *buffer; /**< buffer owned by the caller */
+  size_t size;  /**< size of the buffer */
+  size_t used;  /**< bytes waiting in the buffer */
+  char sep;     /**< field separator */
+  bool ok;      /**< false after a failed write */
+} csv_writer_t;
+
+void csv_reader_init(csv_reader_t *reader, int fd, char *buffer, size_t size,
+                     char sep);
+int csv_read_record(csv_reader_t *reader, Data_t *data);
+bool csv_skip_line(csv_reader_t *reader);
+
+void csv_writer_init(csv_writer_t *writer, int fd, char *buffer, size_t size,
+                     char sep);
+bool csv_write_record(csv_writer_t *writer, const Data_t *data);
+bool csv_write_header(csv_writer_t *writer);
+bool csv_writer_flush(csv_writer_t *writer);
+
+bool List_Import_Csv(List_t *const list, int fd, char *buffer, size_t size,
+                     char sep, bool header, size_t *count);
+bool List_Export_Csv(const List_t *const list, int fd, char *buffer,
+                     size_t size, char sep, bool header);
+
+#endif // CSVIO_H_
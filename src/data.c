@@ -5,6 +5,10 @@
  *      Author: dulik
  */
 
+#include <ctype.h>
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include "data.h"
@@ -38,9 +42,283 @@ bool Data_Get( Data_t * data )
     return true;
 }
 
+bool Data_Read( io_reader_t * reader, Data_t * data )
+{
+    return io_reader_get_string( reader, data->name, sizeof( data->name ) ) &&
+           io_reader_get_double( reader, &data->age ) &&
+           io_reader_get_double( reader, &data->weight ) &&
+           io_reader_get_double( reader, &data->height );
+}
+
 void Data_Print( Data_t * data )
 {
-    printf( "Name=%s, age=%0.1lf, weight=%0.1lf, height=%0.1lf\n",
-            data->name, data->age, data->weight, data->height );
+    char line[DATA_FORMAT_MAX];
+
+    fwrite( line, 1, Data_Format( data, line ), stdout );
+}
+
+/* Hodnoty, pro ktere se x * 10 vejde do 53 bitu mantisy i s rezervou */
+#define FIXED1_FAST_LIMIT 1e14
+
+/*
+ * Vypise val stejne jako printf("%0.1lf"). Rozhodujici je zaokrouhleni
+ * presne hodnoty val * 10 na cele cislo: soucin se spocita jako 8x + 2x
+ * (oba scitance jsou presne) a chyba souctu se ziska presne algoritmem
+ * Fast2Sum. Pokud zaokrouhleny soucin lezi presne v polovine, rozhodne
+ * znamenko chyby, a u skutecne poloviny zaokrouhleni na sudou jako v printf.
+ */
+static size_t format_fixed1( double val, char * out )
+{
+    char digits[24];
+    char * p = out;
+    double a, b, prod, err, frac;
+    uint64_t whole;
+    int n = 0;
+
+    /* Fast2Sum potrebuje presnou aritmetiku double (ne x87 registry) */
+    if( FLT_EVAL_METHOD != 0 ||
+        !( val > -FIXED1_FAST_LIMIT && val < FIXED1_FAST_LIMIT ) ) {
+        return ( size_t )sprintf( out, "%0.1lf", val );
+    }
+
+    if( signbit( val ) ) {
+        *p++ = '-';
+        val = -val;
+    }
+
+    a = val * 8;
+    b = val * 2;
+    prod = a + b;
+    err = b - ( prod - a );
+    whole = ( uint64_t )prod;
+    frac = prod - ( double )whole;
+
+    if( frac > 0.5 || ( frac == 0.5 && ( err > 0 || ( err == 0 && ( whole & 1 ) ) ) ) ) {
+        whole++;
+    }
+
+    digits[n++] = ( char )( '0' + whole % 10 );
+    digits[n++] = '.';
+    whole /= 10;
+
+    do {
+        digits[n++] = ( char )( '0' + whole % 10 );
+        whole /= 10;
+    } while( whole );
+
+    while( n ) {
+        *p++ = digits[--n];
+    }
+
+    return ( size_t )( p - out );
+}
+
+static char * append( char * out, const char * text, size_t len )
+{
+    memcpy( out, text, len );
+    return out + len;
+}
+
+size_t Data_Format( const Data_t * data, char * out )
+{
+    const char * nul = memchr( data->name, 0, sizeof( data->name ) );
+    size_t nameLen = nul ? ( size_t )( nul - data->name ) : sizeof( data->name );
+    char * p = out;
+
+    p = append( p, "Name=", 5 );
+    p = append( p, data->name, nameLen );
+    p = append( p, ", age=", 6 );
+    p += format_fixed1( data->age, p );
+    p = append( p, ", weight=", 9 );
+    p += format_fixed1( data->weight, p );
+    p = append( p, ", height=", 9 );
+    p += format_fixed1( data->height, p );
+    *p++ = '\n';
+    return ( size_t )( p - out );
+}
+
+size_t Data_Format_Batch( const Data_t * data, size_t count, char * out,
+                          size_t size, size_t * used )
+{
+    size_t done = 0;
+    size_t pos = 0;
+
+    while( done < count && size - pos >= DATA_FORMAT_MAX ) {
+        pos += Data_Format( &data[done], out + pos );
+        done++;
+    }
+
+    if( used ) {
+        *used = pos;
+    }
+
+    return done;
+}
+
+
+/* Vrati ukazatel za konec radku zacinajiciho na p, radek bez \r\n konci na *eol */
+static const char * next_line( const char * p, const char * end,
+                               const char ** eol )
+{
+    const char * nl = memchr( p, '\n', ( size_t )( end - p ) );
+    const char * stop = nl ? nl : end;
+
+    if( stop > p && stop[-1] == '\r' ) {
+        stop--;
+    }
+
+    *eol = stop;
+    return nl ? nl + 1 : end;
+}
+
+static bool parse_number_line( const char ** p, const char * end, double * val )
+{
+    const char * q;
+
+    /* cislo nikdy nepresahne konec radku, takze neni treba radek predem
+     * hledat, staci preskocit zbytek radku za cislem */
+    if( !io_utils_parse_double( *p, end, val, &q ) ) {
+        return false;
+    }
+
+    while( q < end && *q != '\n' ) {
+        q++;
+    }
+
+    *p = q < end ? q + 1 : end;
+    return true;
+}
+
+bool Data_Parse( const char ** text, const char * end, Data_t * data )
+{
+    const char * p = *text;
+    const char * eol;
+    size_t nameLen;
+
+    if( p >= end ) {
+        return false;
+    }
+
+    p = next_line( p, end, &eol );
+    nameLen = ( size_t )( eol - *text );
+
+    if( nameLen >= sizeof( data->name ) ) {
+        nameLen = sizeof( data->name ) - 1;
+    }
+
+    memcpy( data->name, *text, nameLen );
+    data->name[nameLen] = 0;
+
+    if( !parse_number_line( &p, end, &data->age ) ||
+        !parse_number_line( &p, end, &data->weight ) ||
+        !parse_number_line( &p, end, &data->height ) ) {
+        return false;
+    }
+
+    *text = p;
+    return true;
+}
+
+size_t Data_Encode( const Data_t * data, unsigned char * out )
+{
+    const char * nul = memchr( data->name, 0, sizeof( data->name ) - 1 );
+    size_t nameLen = nul ? ( size_t )( nul - data->name ) : sizeof( data->name ) - 1;
+    unsigned char * p = out;
+
+    *p++ = ( unsigned char )nameLen;
+    memcpy( p, data->name, nameLen );
+    p += nameLen;
+    memcpy( p, &data->age, sizeof( double ) );
+    p += sizeof( double );
+    memcpy( p, &data->weight, sizeof( double ) );
+    p += sizeof( double );
+    memcpy( p, &data->height, sizeof( double ) );
+    p += sizeof( double );
+    return ( size_t )( p - out );
+}
+
+size_t Data_Decode( const unsigned char * in, size_t avail, Data_t * data )
+{
+    size_t nameLen;
+    size_t total;
+
+    if( avail < 1 ) {
+        return 0;
+    }
+
+    nameLen = in[0];
+    total = 1 + nameLen + 3 * sizeof( double );
+
+    if( nameLen >= sizeof( data->name ) || total > avail ) {
+        return 0;
+    }
+
+    in++;
+    memcpy( data->name, in, nameLen );
+    data->name[nameLen] = 0;
+    in += nameLen;
+    memcpy( &data->age, in, sizeof( double ) );
+    in += sizeof( double );
+    memcpy( &data->weight, in, sizeof( double ) );
+    in += sizeof( double );
+    memcpy( &data->height, in, sizeof( double ) );
+    return total;
+}
+
+bool Data_Field_Parse( const char * name, size_t len, Data_Field_t * field )
+{
+    static const char * const names[] = { "name", "age", "weight", "height" };
+
+    for( size_t i = 0; i < sizeof( names ) / sizeof( names[0] ); i++ ) {
+        size_t j = 0;
+
+        if( strlen( names[i] ) != len ) {
+            continue;
+        }
+
+        while( j < len && tolower( ( unsigned char )name[j] ) == names[i][j] ) {
+            j++;
+        }
+
+        if( j == len ) {
+            *field = ( Data_Field_t )i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+size_t Data_Field_Offset( Data_Field_t field )
+{
+    switch( field ) {
+        case DATA_FIELD_AGE:
+            return offsetof( Data_t, age );
+
+        case DATA_FIELD_WEIGHT:
+            return offsetof( Data_t, weight );
+
+        case DATA_FIELD_HEIGHT:
+            return offsetof( Data_t, height );
+
+        default:
+            return offsetof( Data_t, name );
+    }
 }
 
+double Data_Field_Value( const Data_t * data, Data_Field_t field )
+{
+    switch( field ) {
+        case DATA_FIELD_AGE:
+            return data->age;
+
+        case DATA_FIELD_WEIGHT:
+            return data->weight;
+
+        case DATA_FIELD_HEIGHT:
+            return data->height;
+
+        default:
+            return 0;
+    }
+}
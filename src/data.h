@@ -9,6 +9,14 @@
 #define DATA_H_
 
 #include <stdbool.h>
+#include <stddef.h>
+#include "ioutils.h"
+
+/** Nejvetsi delka radku vytvoreneho funkci Data_Format (vcetne \n) */
+#define DATA_FORMAT_MAX 1280
+
+/** Nejvetsi delka zaznamu zakodovaneho funkci Data_Encode */
+#define DATA_ENCODED_MAX ( 1 + 254 + 3 * sizeof( double ) )
 
 /************************************************************************/
 /** \struct Data_t
@@ -19,6 +27,17 @@ typedef struct {
     double age, weight, height; /**< vek, vaha, vyska */
 } Data_t;
 
+/************************************************************************/
+/** \enum Data_Field_t
+ * Polozky zaznamu, podle kterych se da vybirat, radit a pocitat.
+ */
+typedef enum {
+    DATA_FIELD_NAME,   /**< Data_t::name */
+    DATA_FIELD_AGE,    /**< Data_t::age */
+    DATA_FIELD_WEIGHT, /**< Data_t::weight */
+    DATA_FIELD_HEIGHT  /**< Data_t::height */
+} Data_Field_t;
+
 /************************************************************************/
 /** \fn int Data_Get(Data_t* data)
  * \brief Ziska od uzivatele hodnoty pro data jednoho uzlu seznamu
@@ -28,5 +47,94 @@ typedef struct {
 bool Data_Get( Data_t * data );
 void Data_Print( Data_t * data );
 
+/************************************************************************/
+/** \fn bool Data_Read(io_reader_t * reader, Data_t * data)
+ * \brief Precte hodnoty jednoho uzlu stejne jako Data_Get, ale z bufferovaneho
+ * cteni a bez vyzev pro uzivatele (davkovy rezim)
+ * \param reader - zdroj dat
+ * \param data - ukazatel na strukturu data, kterou ma funkce naplnit
+ */
+bool Data_Read( io_reader_t * reader, Data_t * data );
+
+/************************************************************************/
+/** \fn size_t Data_Format(const Data_t * data, char * out)
+ * \brief Zapise zaznam do bufferu presne v podobe, jakou tiskne Data_Print
+ * ("Name=%s, age=%0.1lf, weight=%0.1lf, height=%0.1lf\n"), bez printf
+ * \param data - zaznam, ktery se ma zapsat
+ * \param out - buffer o velikosti alespon #DATA_FORMAT_MAX bajtu, vysledek
+ * neni ukoncen nulou
+ * \return pocet zapsanych bajtu
+ */
+size_t Data_Format( const Data_t * data, char * out );
+
+/************************************************************************/
+/** \fn size_t Data_Format_Batch(const Data_t * data, size_t count, char * out, size_t size, size_t * used)
+ * \brief Zapise za sebou tolik zaznamu z pole, kolik se jich vejde do bufferu
+ * \param data - pole zaznamu
+ * \param count - pocet zaznamu v poli
+ * \param out - vystupni buffer
+ * \param size - velikost vystupniho bufferu
+ * \param used - pocet zapsanych bajtu
+ * \return pocet zapsanych zaznamu
+ */
+size_t Data_Format_Batch( const Data_t * data, size_t count, char * out,
+                          size_t size, size_t * used );
+
+/************************************************************************/
+/** \fn bool Data_Parse(const char ** text, const char * end, Data_t * data)
+ * \brief Precte jeden zaznam ve formatu Data_Get (jmeno, vek, vaha a vyska,
+ * kazde na samostatnem radku) z pameti, bez stdio
+ * \param text - ukazatel na zacatek zaznamu, po uspechu ukazuje za zaznam
+ * \param end - konec textu (text nemusi byt ukoncen nulou)
+ * \param data - struktura, do ktere se zaznam ulozi; u jmena se zapise
+ * jen jeho pouzita cast
+ * \return false, pokud zaznam neni kompletni nebo cislo nejde precist
+ */
+bool Data_Parse( const char ** text, const char * end, Data_t * data );
+
+/************************************************************************/
+/** \fn size_t Data_Encode(const Data_t * data, unsigned char * out)
+ * \brief Zakoduje zaznam do kompaktni binarni podoby: delka jmena (1 bajt),
+ * jmeno bez ukoncovaci nuly a tri cisla double v nativnim poradi bajtu
+ * \param data - zaznam, ktery se ma zakodovat
+ * \param out - buffer o velikosti alespon #DATA_ENCODED_MAX bajtu
+ * \return pocet zapsanych bajtu
+ */
+size_t Data_Encode( const Data_t * data, unsigned char * out );
+
+/************************************************************************/
+/** \fn size_t Data_Decode(const unsigned char * in, size_t avail, Data_t * data)
+ * \brief Dekoduje zaznam zakodovany funkci Data_Encode
+ * \param in - zacatek zakodovaneho zaznamu
+ * \param avail - pocet bajtu, ktere je mozne precist
+ * \param data - struktura, do ktere se zaznam ulozi
+ * \return pocet prectenych bajtu, 0 pokud zaznam neni kompletni nebo platny
+ */
+size_t Data_Decode( const unsigned char * in, size_t avail, Data_t * data );
+
+/************************************************************************/
+/** \fn bool Data_Field_Parse(const char * name, size_t len, Data_Field_t * field)
+ * \brief Najde polozku zaznamu podle jejiho jmena ("name", "age", "weight",
+ * "height"), na velikosti pismen nezalezi
+ * \param name - jmeno polozky (nemusi byt ukonceno nulou)
+ * \param len - delka jmena
+ * \param field - nalezena polozka
+ * \return false, pokud zaznam takovou polozku nema
+ */
+bool Data_Field_Parse( const char * name, size_t len, Data_Field_t * field );
+
+/************************************************************************/
+/** \fn size_t Data_Field_Offset(Data_Field_t field)
+ * \brief Vrati posun ciselne polozky ve strukture Data_t, aby ji slo cist
+ * bez rozhodovani podle typu polozky
+ */
+size_t Data_Field_Offset( Data_Field_t field );
+
+/************************************************************************/
+/** \fn double Data_Field_Value(const Data_t * data, Data_Field_t field)
+ * \brief Vrati hodnotu ciselne polozky zaznamu, pro jmeno vraci 0
+ */
+double Data_Field_Value( const Data_t * data, Data_Field_t field );
+
 
 #endif /* DATA_H_ */
@@ -0,0 +1,239 @@
+/**
+ * @file       ilist.c
+ * @date       10/2026
+ * @brief      Linear list in two arrays linked by 32-bit indices
+ * ****************************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * New items take the first released index, or the next never used one.
+ * When the arrays are full both are doubled with realloc; since items refer
+ * to each other by index, moving the arrays needs no fix-up.
+ */
+
+/* Private includes -------------------------------------------------------- */
+#include "ilist.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Private constants ------------------------------------------------------- */
+#define ILIST_MIN_CAPACITY 64u
+#define ILIST_MAX_CAPACITY UINT32_MAX
+
+/* Private functions ------------------------------------------------------- */
+
+static bool grow(IList_t* const list, uint64_t capacity) {
+    Data_t* data;
+    uint32_t* next;
+
+    if(capacity > ILIST_MAX_CAPACITY)
+        capacity = ILIST_MAX_CAPACITY;
+    if(capacity <= list->capacity || capacity > SIZE_MAX / sizeof(Data_t))
+        return false;
+    data = realloc(list->data, (size_t)capacity * sizeof(Data_t));
+    if(!data)
+        return false;
+    list->data = data;
+    next = realloc(list->next, (size_t)capacity * sizeof(uint32_t));
+    if(!next)
+        return false;
+    list->next = next;
+    list->capacity = (uint32_t)capacity;
+    return true;
+}
+
+/** Returns a free index, 0 if the arrays could not grow */
+static uint32_t node_alloc(IList_t* const list) {
+    uint32_t index = list->free;
+
+    if(index) {
+        list->free = list->next[index];
+        return index;
+    }
+    if(!list->used)
+        list->used = 1; /* index 0 means none */
+    if(list->used >= list->capacity) {
+        uint64_t capacity = (uint64_t)list->capacity * 2;
+
+        if(capacity < ILIST_MIN_CAPACITY)
+            capacity = ILIST_MIN_CAPACITY;
+        if(!grow(list, capacity))
+            return 0;
+    }
+    return list->used++;
+}
+
+static void node_free(IList_t* const list, uint32_t index) {
+    list->next[index] = list->free;
+    list->free = index;
+    list->count--;
+}
+
+/** Links a new item after the item at index, at the start if it is 0 */
+static uint32_t insert_after(IList_t* const list, uint32_t index, const Data_t* data) {
+    uint32_t fresh = node_alloc(list);
+
+    if(!fresh)
+        return 0;
+    list->data[fresh] = *data;
+    if(index) {
+        list->next[fresh] = list->next[index];
+        list->next[index] = fresh;
+    } else {
+        list->next[fresh] = list->first;
+        list->first = fresh;
+    }
+    list->count++;
+    return fresh;
+}
+
+/* Functions definitions --------------------------------------------------- */
+
+void IList_Init(IList_t* const list) {
+    if(!list)
+        return;
+    memset(list, 0, sizeof(*list));
+}
+
+void IList_Free(IList_t* const list) {
+    if(!list)
+        return;
+    free(list->data);
+    free(list->next);
+    memset(list, 0, sizeof(*list));
+}
+
+bool IList_Reserve(IList_t* const list, size_t items) {
+    if(!list)
+        return false;
+    if(items >= ILIST_MAX_CAPACITY)
+        return false;
+    if(items + 1 <= list->capacity)
+        return true;
+    return grow(list, (uint64_t)items + 1);
+}
+
+size_t IList_Count(const IList_t* const list) {
+    if(!list)
+        return 0;
+    return list->count;
+}
+
+bool IList_Insert_First(IList_t* const list, Data_t data) {
+    if(!list)
+        return false;
+    return insert_after(list, 0, &data) != 0;
+}
+
+void IList_First(IList_t* const list) {
+    if(!list)
+        return;
+    list->active = list->first;
+}
+
+bool IList_Copy_First(const IList_t* const list, Data_t* data) {
+    if(!list || !data || !list->first)
+        return false;
+    *data = list->data[list->first];
+    return true;
+}
+
+void IList_Delete_First(IList_t* const list) {
+    uint32_t late;
+
+    if(!list || !list->first)
+        return;
+    late = list->first;
+    if(list->active == late)
+        list->active = 0;
+    list->first = list->next[late];
+    node_free(list, late);
+}
+
+void IList_Post_Delete(IList_t* const list) {
+    uint32_t late;
+
+    if(!list || !list->active)
+        return;
+    late = list->next[list->active];
+    if(!late)
+        return;
+    list->next[list->active] = list->next[late];
+    node_free(list, late);
+}
+
+bool IList_Post_Insert(IList_t* const list, Data_t data) {
+    if(!list || !list->active)
+        return false;
+    return insert_after(list, list->active, &data) != 0;
+}
+
+bool IList_Copy(const IList_t* const list, Data_t* data) {
+    if(!list || !data || !list->active)
+        return false;
+    *data = list->data[list->active];
+    return true;
+}
+
+void IList_Actualize(IList_t* const list, Data_t data) {
+    if(!list || !list->active)
+        return;
+    list->data[list->active] = data;
+}
+
+void IList_Succ(IList_t* const list) {
+    if(!list || !list->active)
+        return;
+    list->active = list->next[list->active];
+}
+
+bool IList_Is_Active(const IList_t* const list) {
+    return list && list->active;
+}
+
+bool IList_Seek(IList_t* const list, size_t position) {
+    uint32_t index;
+
+    if(!list || position >= list->count)
+        return false;
+    for(index = list->first; position; position--)
+        index = list->next[index];
+    list->active = index;
+    return true;
+}
+
+bool IList_Import(IList_t* const list, List_t source) {
+    uint32_t last;
+
+    if(!list)
+        return false;
+    last = list->first;
+    if(last) {
+        while(list->next[last])
+            last = list->next[last];
+    }
+    for(const List_Node_t* node = source.first; node; node = node->next) {
+        last = insert_after(list, last, &node->data);
+        if(!last)
+            return false;
+    }
+    return true;
+}
+
+bool IList_Export(const IList_t* const list, List_t* const target) {
+    List_Node_t* last;
+
+    if(!list || !target)
+        return false;
+    last = target->first;
+    if(last) {
+        while(last->next)
+            last = last->next;
+    }
+    for(uint32_t index = list->first; index; index = list->next[index]) {
+        last = List_Insert_After(target, last, list->data[index]);
+        if(!last)
+            return false;
+    }
+    return true;
+}
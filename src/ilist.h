@@ -0,0 +1,142 @@
+/**
+ * @file       ilist.h
+ * @date       10/2026
+ * @brief      Linear list in two arrays linked by 32-bit indices
+ * **********************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * An IList_t keeps the data of its items in one array and their links in a
+ * second, parallel array of uint32_t indices; the first and the active item
+ * are indices too. Compared with List_t, an item costs 4 bytes of link
+ * instead of an 8 byte pointer plus a malloc block header, walks that only
+ * follow links, like IList_Seek, read 16 links per cache line, and the
+ * whole list can be moved or copied as two blocks of
+ * memory because nothing in it is an address. Index 0 is never used and
+ * means none, so a zeroed IList_t is an empty list. The operations mirror
+ * the List_* API; an IList_t holds at most 2^32 - 2 items.
+ */
+
+#ifndef ILIST_H
+#define ILIST_H
+
+/* Public includes --------------------------------------------------------- */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "list.h"
+
+/** @struct IList_t
+ * List of items addressed by their index in the arrays
+ */
+typedef struct {
+  Data_t* data;      /**< data of item i at data[i] */
+  uint32_t* next;    /**< index of the item after item i, 0 for none */
+  uint32_t capacity; /**< items the arrays can hold, including index 0 */
+  uint32_t used;     /**< indices handed out so far, including index 0 */
+  uint32_t free;     /**< first released index, chained through next */
+  uint32_t first;    /**< index of the first item, 0 if empty */
+  uint32_t active;   /**< index of the active item, 0 if none */
+  uint32_t count;    /**< number of items */
+} IList_t;
+
+/* Public IList_t API ------------------------------------------------------ */
+/**
+ * @brief Initializes an empty list without allocating
+ */
+void IList_Init(IList_t* const list);
+
+/**
+ * @brief Releases the arrays, the list is empty afterwards
+ */
+void IList_Free(IList_t* const list);
+
+/**
+ * @brief Grows the arrays to hold at least items items, so that inserts up
+ * to that count do not reallocate
+ * @return Returns false if the arrays could not grow
+ */
+bool IList_Reserve(IList_t* const list, size_t items);
+
+/**
+ * @brief Returns the number of items in the list
+ */
+size_t IList_Count(const IList_t* const list);
+
+/**
+ * @brief Creates a new item at the start of the list, the active item stays
+ * the same
+ * @return Returns false if the arrays could not grow
+ */
+bool IList_Insert_First(IList_t* const list, Data_t data);
+
+/**
+ * @brief Sets the first item active
+ */
+void IList_First(IList_t* const list);
+
+/**
+ * @brief Returns data of the first item
+ * @return Returns false if the list is empty
+ */
+bool IList_Copy_First(const IList_t* const list, Data_t* data);
+
+/**
+ * @brief Deletes the first item, if it was active the list has no active item
+ */
+void IList_Delete_First(IList_t* const list);
+
+/**
+ * @brief Deletes the item after the active item
+ */
+void IList_Post_Delete(IList_t* const list);
+
+/**
+ * @brief Inserts a new item after the active item, if there is one
+ * @return Returns false if there is no active item or the arrays could not
+ * grow
+ */
+bool IList_Post_Insert(IList_t* const list, Data_t data);
+
+/**
+ * @brief Returns data of the active item
+ * @return Returns false if there is no active item
+ */
+bool IList_Copy(const IList_t* const list, Data_t* data);
+
+/**
+ * @brief Updates data of the active item, if there is one
+ */
+void IList_Actualize(IList_t* const list, Data_t data);
+
+/**
+ * @brief Moves the active item to the next one
+ */
+void IList_Succ(IList_t* const list);
+
+/**
+ * @brief Returns true if there is an active item
+ */
+bool IList_Is_Active(const IList_t* const list);
+
+/**
+ * @brief Sets the active item to the item at the given position, following
+ * only the links
+ * @param position[in] - zero based position of the item
+ * @return Returns false and keeps the active item if there is no such item
+ */
+bool IList_Seek(IList_t* const list, size_t position);
+
+/**
+ * @brief Appends all items of a pointer-linked list at the end of the list
+ * @return Returns false if the arrays could not grow, the items appended so
+ * far stay
+ */
+bool IList_Import(IList_t* const list, List_t source);
+
+/**
+ * @brief Appends all items of the list at the end of a pointer-linked list
+ * @return Returns false if an item could not be allocated
+ */
+bool IList_Export(const IList_t* const list, List_t* const target);
+
+#endif /* ILIST_H */
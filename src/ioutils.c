@@ -5,10 +5,27 @@
  * \brief   Miniknihovna pro načítání vstupu
  */
 
+#if !defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 200809L
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "ioutils.h"
+#include <errno.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+
+/** Count of significant digits that fit into the 64-bit mantissa. */
+#define PARSE_MAX_DIGITS 19
+/** Largest mantissa exactly representable in a double (2^53). */
+#define PARSE_MAX_EXACT (UINT64_C(1) << 53)
+/** Longest number text copied to the stack for strtod, longer ones go to the
+ * heap. */
+#define PARSE_FALLBACK_LEN 64
 
 bool get_string(char *line, int len);
 
@@ -117,9 +134,449 @@ bool io_utils_get_double(double *val) {
 }
 
 /**
- * @brief Clears one line of input.
+ * @brief Clears one line of input. The line is skipped in blocks instead of
+ *        one fgetc() per character.
  */
 void io_utils_clear_stdin() {
-  while (fgetc(stdin) != '\n')
+  char chunk[256];
+
+  while (fgets(chunk, sizeof(chunk), stdin) != NULL &&
+         strchr(chunk, '\n') == NULL)
     ;
 }
+
+static const double pow10_exact[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/**
+ * @brief   Fallback for numbers the fast path can't convert exactly
+ *          (too many digits, large exponents, inf/nan, hex floats).
+ */
+static bool parse_double_slow(const char *str, const char *end, double *val,
+                              const char **next) {
+  char buffer[PARSE_FALLBACK_LEN];
+  char *copy = buffer;
+  const char *p = str;
+  char *stop;
+  size_t len;
+
+  /* a number never contains white space, so the whole token is copied and
+   * strtod can't continue on the next line */
+  while (p < end && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r' &&
+         *p != '\v' && *p != '\f') {
+    p++;
+  }
+
+  len = (size_t)(p - str);
+
+  if (len >= sizeof(buffer)) {
+    copy = malloc(len + 1);
+
+    if (copy == NULL) {
+      return false;
+    }
+  }
+
+  memcpy(copy, str, len);
+  copy[len] = 0;
+  *val = strtod(copy, &stop);
+  len = (size_t)(stop - copy);
+
+  if (copy != buffer) {
+    free(copy);
+  }
+
+  if (len == 0) {
+    return false;
+  }
+
+  if (next) {
+    *next = str + len;
+  }
+
+  return true;
+}
+
+/**
+ * @brief   Converts decimal text in [str, end) to a double without touching
+ *          stdio. Leading blanks are skipped, the number ends at
+ *          the first character that can't be a part of it, it never
+ *          continues past the end of line. Numbers with at
+ *          most 19 significant digits and a small exponent are converted
+ *          exactly in the fast path, the rest is handed over to strtod,
+ *          which uses the decimal point of the current locale.
+ * @param   str     Start of the text.
+ * @param   end     End of the text (the text doesn't have to be terminated).
+ * @param   val     Pointer to a double type variable
+ *                      where the result is stored.
+ * @param   next    If not NULL, receives pointer behind the parsed number.
+ * @return  Returns false if the text doesn't start with a number.
+ */
+bool io_utils_parse_double(const char *str, const char *end, double *val,
+                           const char **next) {
+  const char *p = str;
+  uint64_t mantissa = 0;
+  int significant = 0;
+  int exponent = 0;
+  bool negative = false;
+  bool any = false;
+
+  if (str == NULL || end == NULL || val == NULL) {
+    return false;
+  }
+
+  while (p < end && (*p == ' ' || *p == '\t')) {
+    p++;
+  }
+
+  str = p;
+
+  if (p < end && (*p == '-' || *p == '+')) {
+    negative = (*p == '-');
+    p++;
+  }
+
+  while (p < end && *p >= '0' && *p <= '9') {
+    if (significant < PARSE_MAX_DIGITS) {
+      mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+      significant += (mantissa != 0);
+    } else {
+      exponent++;
+    }
+
+    any = true;
+    p++;
+  }
+
+  if (p < end && *p == '.') {
+    p++;
+
+    while (p < end && *p >= '0' && *p <= '9') {
+      if (significant < PARSE_MAX_DIGITS) {
+        mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+        significant += (mantissa != 0);
+        exponent--;
+      }
+
+      any = true;
+      p++;
+    }
+  }
+
+  if (!any || (p < end && (*p == 'x' || *p == 'X'))) {
+    /* inf, nan, hex floats etc. */
+    return parse_double_slow(str, end, val, next);
+  }
+
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    const char *e = p + 1;
+    bool expNegative = false;
+    int expValue = 0;
+
+    if (e < end && (*e == '-' || *e == '+')) {
+      expNegative = (*e == '-');
+      e++;
+    }
+
+    if (e < end && *e >= '0' && *e <= '9') {
+      while (e < end && *e >= '0' && *e <= '9') {
+        if (expValue < 100000) {
+          expValue = expValue * 10 + (*e - '0');
+        }
+
+        e++;
+      }
+
+      exponent += expNegative ? -expValue : expValue;
+      p = e;
+    }
+  }
+
+  if (significant >= PARSE_MAX_DIGITS || mantissa > PARSE_MAX_EXACT ||
+      exponent < -22 || exponent > 22) {
+    return parse_double_slow(str, end, val, next);
+  }
+
+  /* Both the mantissa and 10^|exponent| are exact doubles, so a single
+   * multiplication or division is correctly rounded. */
+  *val = (double)mantissa;
+
+  if (exponent < 0) {
+    *val /= pow10_exact[-exponent];
+  } else {
+    *val *= pow10_exact[exponent];
+  }
+
+  if (negative) {
+    *val = -*val;
+  }
+
+  if (next) {
+    *next = p;
+  }
+
+  return true;
+}
+
+/**
+ * @brief   Converts decimal integer text in [str, end) to a long without
+ *          stdio. Leading blanks are skipped.
+ * @param   val     Pointer to a long type variable
+ *                      where the result is stored.
+ * @param   next    If not NULL, receives pointer behind the parsed number.
+ * @return  Returns false if the text doesn't start with a number or the
+ *          number doesn't fit in a long.
+ */
+bool io_utils_parse_long(const char *str, const char *end, long *val,
+                         const char **next) {
+  const char *p = str;
+  unsigned long value = 0;
+  unsigned long limit;
+  bool negative = false;
+
+  if (str == NULL || end == NULL || val == NULL) {
+    return false;
+  }
+
+  while (p < end && (*p == ' ' || *p == '\t')) {
+    p++;
+  }
+
+  if (p < end && (*p == '-' || *p == '+')) {
+    negative = (*p == '-');
+    p++;
+  }
+
+  if (p >= end || *p < '0' || *p > '9') {
+    return false;
+  }
+
+  limit = negative ? (unsigned long)LONG_MAX + 1 : (unsigned long)LONG_MAX;
+
+  while (p < end && *p >= '0' && *p <= '9') {
+    unsigned digit = (unsigned)(*p - '0');
+
+    if (value > (limit - digit) / 10) {
+      return false;
+    }
+
+    value = value * 10 + digit;
+    p++;
+  }
+
+  *val = negative ? (long)(0 - value) : (long)value;
+
+  if (next) {
+    *next = p;
+  }
+
+  return true;
+}
+
+/**
+ * @brief   Prepares a reader over a file descriptor.
+ * @param   size    Initial buffer size, 0 for #IO_READER_DEFAULT_SIZE.
+ * @return  Returns false if the buffer can't be allocated.
+ */
+bool io_reader_open_fd(io_reader_t *reader, int fd, size_t size) {
+  if (reader == NULL) {
+    return false;
+  }
+
+  memset(reader, 0, sizeof(*reader));
+  reader->fd = fd;
+  reader->size = size ? size : IO_READER_DEFAULT_SIZE;
+  reader->buffer = malloc(reader->size);
+  return reader->buffer != NULL;
+}
+
+/**
+ * @brief   Prepares a reader over a stream. The stream is read with one
+ *          fread() per buffer.
+ * @param   size    Initial buffer size, 0 for #IO_READER_DEFAULT_SIZE.
+ * @return  Returns false if the buffer can't be allocated.
+ */
+bool io_reader_open_file(io_reader_t *reader, FILE *file, size_t size) {
+  if (file == NULL || !io_reader_open_fd(reader, -1, size)) {
+    return false;
+  }
+
+  reader->file = file;
+  return true;
+}
+
+/**
+ * @brief   Releases the buffer, the source itself is left open.
+ */
+void io_reader_close(io_reader_t *reader) {
+  if (reader == NULL) {
+    return;
+  }
+
+  free(reader->buffer);
+  reader->buffer = NULL;
+  reader->size = reader->start = reader->end = 0;
+}
+
+/**
+ * @brief   Moves unread data to the start of the buffer, grows the buffer if
+ *          it is full and reads one more block.
+ */
+static bool reader_fill(io_reader_t *reader) {
+  size_t n;
+
+  if (reader->eof || reader->error) {
+    return false;
+  }
+
+  if (reader->start > 0) {
+    memmove(reader->buffer, reader->buffer + reader->start,
+            reader->end - reader->start);
+    reader->end -= reader->start;
+    reader->start = 0;
+  }
+
+  if (reader->end == reader->size) {
+    char *bigger = realloc(reader->buffer, reader->size * 2);
+
+    if (bigger == NULL) {
+      reader->error = true;
+      return false;
+    }
+
+    reader->buffer = bigger;
+    reader->size *= 2;
+  }
+
+  if (reader->file != NULL) {
+    n = fread(reader->buffer + reader->end, 1, reader->size - reader->end,
+              reader->file);
+
+    if (n == 0) {
+      reader->eof = !ferror(reader->file);
+      reader->error = !reader->eof;
+    }
+  } else {
+    ssize_t got;
+
+    do {
+      got = read(reader->fd, reader->buffer + reader->end,
+                 reader->size - reader->end);
+    } while (got < 0 && errno == EINTR);
+
+    reader->eof = got == 0;
+    reader->error = got < 0;
+    n = got > 0 ? (size_t)got : 0;
+  }
+
+  reader->end += n;
+  return n > 0;
+}
+
+/**
+ * @brief   Returns the next line as a view into the reader's buffer. The
+ *          view stays valid until the next call on the reader. Line breaks
+ *          (\n or \r\n) are not part of the line, the last line doesn't
+ *          need one.
+ * @return  Returns false at the end of input or on read error.
+ */
+bool io_reader_next_line(io_reader_t *reader, io_line_t *line) {
+  size_t scanned = 0;
+
+  if (reader == NULL || line == NULL || reader->buffer == NULL) {
+    return false;
+  }
+
+  for (;;) {
+    char *p = reader->buffer + reader->start;
+    size_t avail = reader->end - reader->start;
+    char *nl = memchr(p + scanned, '\n', avail - scanned);
+
+    if (nl != NULL || (reader->eof && avail > 0)) {
+      size_t len = nl != NULL ? (size_t)(nl - p) : avail;
+
+      reader->start += nl != NULL ? len + 1 : len;
+
+      if (len > 0 && p[len - 1] == '\r') {
+        len--;
+      }
+
+      line->ptr = p;
+      line->len = len;
+      return true;
+    }
+
+    scanned = avail;
+
+    if (!reader_fill(reader) && !(reader->eof && reader->start < reader->end)) {
+      return false;
+    }
+  }
+}
+
+/**
+ * @brief   Copies the next line without the line break into c.
+ * @param   maxLen  Size of c, longer lines are truncated.
+ */
+bool io_reader_get_string(io_reader_t *reader, char *c, int maxLen) {
+  io_line_t line;
+
+  if (c == NULL || maxLen <= 0 || !io_reader_next_line(reader, &line)) {
+    return false;
+  }
+
+  if (line.len >= (size_t)maxLen) {
+    line.len = (size_t)maxLen - 1;
+  }
+
+  memcpy(c, line.ptr, line.len);
+  c[line.len] = 0;
+  return true;
+}
+
+/**
+ * @brief   Loads the first character of the next line.
+ */
+bool io_reader_get_char(io_reader_t *reader, char *c) {
+  io_line_t line;
+
+  if (c == NULL || !io_reader_next_line(reader, &line)) {
+    return false;
+  }
+
+  *c = line.len > 0 ? line.ptr[0] : '\n';
+  return true;
+}
+
+/**
+ * @brief   Loads a long from the next line, like io_utils_get_long, but
+ *          lines in a wrong format are skipped silently.
+ */
+bool io_reader_get_long(io_reader_t *reader, long *val) {
+  io_line_t line;
+
+  while (io_reader_next_line(reader, &line)) {
+    if (io_utils_parse_long(line.ptr, line.ptr + line.len, val, NULL)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * @brief   Loads a double from the next line, like io_utils_get_double, but
+ *          lines in a wrong format are skipped silently.
+ */
+bool io_reader_get_double(io_reader_t *reader, double *val) {
+  io_line_t line;
+
+  while (io_reader_next_line(reader, &line)) {
+    if (io_utils_parse_double(line.ptr, line.ptr + line.len, val, NULL)) {
+      return true;
+    }
+  }
+
+  return false;
+}
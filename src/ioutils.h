@@ -9,6 +9,33 @@
 #define IOUTILS_H_
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/** Default buffer size of io_reader_t. */
+#define IO_READER_DEFAULT_SIZE (64 * 1024)
+
+/**
+ * Buffered reader over a file descriptor or a FILE stream. Data are read in
+ * large blocks into the reader's own buffer and lines are handed out as views
+ * into it, so reading a line costs neither a stdio call nor a copy.
+ */
+typedef struct {
+  int fd;       /**< source descriptor, -1 when reading from file */
+  FILE *file;   /**< source stream, NULL when reading from fd */
+  char *buffer; /**< owned buffer, grows for lines longer than it */
+  size_t size;  /**< size of the buffer */
+  size_t start; /**< first unread byte */
+  size_t end;   /**< end of valid data */
+  bool eof;     /**< source is exhausted */
+  bool error;   /**< reading failed */
+} io_reader_t;
+
+/** View of one line inside the reader's buffer, without the line break. */
+typedef struct {
+  const char *ptr; /**< first character of the line */
+  size_t len;      /**< length of the line */
+} io_line_t;
 
 bool io_utils_get_string( char * c, int maxLen );
 bool io_utils_get_char( char * c );
@@ -16,5 +43,19 @@ bool io_utils_get_long( long * val );
 bool io_utils_get_double( double * val );
 void io_utils_clear_stdin();
 
+bool io_utils_parse_double( const char * str, const char * end, double * val,
+                            const char ** next );
+bool io_utils_parse_long( const char * str, const char * end, long * val,
+                          const char ** next );
+
+bool io_reader_open_fd( io_reader_t * reader, int fd, size_t size );
+bool io_reader_open_file( io_reader_t * reader, FILE * file, size_t size );
+void io_reader_close( io_reader_t * reader );
+bool io_reader_next_line( io_reader_t * reader, io_line_t * line );
+bool io_reader_get_string( io_reader_t * reader, char * c, int maxLen );
+bool io_reader_get_char( io_reader_t * reader, char * c );
+bool io_reader_get_long( io_reader_t * reader, long * val );
+bool io_reader_get_double( io_reader_t * reader, double * val );
+
 
 #endif //_IOUTILS_H_
@@ -8,14 +8,228 @@
  * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
  */
 
+#if !defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 200809L
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 /* Private includes -------------------------------------------------------- */
 #include "list.h"
+#include "aggregate.h"
+#include "arena.h"
+#include "bloom.h"
+#include "list_ext.h"
+#include "order.h"
+#include "sketch.h"
 
 #include <ctype.h>
+#include <errno.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+
+/* Private constants ------------------------------------------------------- */
+/** Size of the List_Dump output buffer */
+#define LIST_DUMP_BUFFER (256 * 1024)
+/** Fewest deleted items for which the lazy delete mode reclaims by itself */
+#define LIST_RECLAIM_MIN 64
+/** Most dead items a delete releases in the lazy delete mode */
+#define LIST_RECLAIM_STEP 4
+/** Keeps a rarely taken path out of its caller */
+#ifdef __GNUC__
+#define LIST_NOINLINE __attribute__((noinline))
+#else
+#define LIST_NOINLINE
+#endif
+
+#ifdef LIST_STATS
+#define LIST_STAT_ADD(list, field, n)                                          \
+    do {                                                                       \
+        if((list).stats)                                                       \
+            __atomic_fetch_add(&(list).stats->field, (n), __ATOMIC_RELAXED);   \
+    } while(0)
+#define LIST_STAT_SET(list, field, n)                                          \
+    do {                                                                       \
+        if((list).stats)                                                       \
+            __atomic_store_n(&(list).stats->field, (n), __ATOMIC_RELAXED);     \
+    } while(0)
+#else
+#define LIST_STAT_ADD(list, field, n) ((void)0)
+#define LIST_STAT_SET(list, field, n) ((void)0)
+#endif
+
+/* Private functions ------------------------------------------------------- */
+
+static bool write_all(int fd, const char* data, size_t len) {
+    while(len) {
+        ssize_t n = write(fd, data, len);
+        if(n < 0 && errno == EINTR)
+            continue;
+        if(n <= 0)
+            return false;
+        data += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+/**
+ * @brief Allocates an item from the arena of the list, if any, or myMalloc
+ */
+static List_Node_t* node_alloc(List_Ext_t* ext) {
+    if(ext && ext->arena) {
+        List_Node_t* node = List_Arena_Alloc(ext->arena);
+        if(node)
+            return node;
+    }
+    return myMalloc(sizeof(List_Node_t));
+}
+
+static void node_free(List_Ext_t* ext, List_Node_t* node) {
+    if(ext && ext->arena && node && List_Arena_Free(ext->arena, node))
+        return;
+    myFree(node);
+}
+
+/**
+ * @brief Updates the attachments of the list for an item being linked, the
+ * index is updated by the caller
+ */
+static void node_linked(List_Ext_t* ext, const List_Node_t* node) {
+    if(ext->bloom)
+        List_Bloom_Add(ext->bloom, node->data.name);
+    if(ext->sketch)
+        List_Sketch_Add(ext->sketch, &node->data);
+    if(ext->aggregate)
+        List_Aggregate_Add(ext->aggregate, &node->data);
+    if(ext->lazy)
+        ext->lazy->live++;
+}
+
+/**
+ * @brief List_Link_After with the attachments already looked up
+ */
+static void link_after(List_t* const list, List_Ext_t* ext, List_Node_t* node,
+                       List_Node_t* newNode) {
+    if(ext && ext->order && !List_Order_Link(ext->order, node, newNode)) {
+        List_Order_Detach(list);
+        ext = list->ext;
+    }
+    if(ext)
+        node_linked(ext, newNode);
+    if(node) {
+        newNode->next = node->next;
+        node->next = newNode;
+    } else {
+        newNode->next = list->first;
+        list->first = newNode;
+    }
+}
+
+/**
+ * @brief Updates the attachments of the list for an item being unlinked
+ */
+static void node_unlinked(List_t* const list, List_Ext_t* ext, List_Node_t* node) {
+    if(list->active == node)
+        list->active = NULL;
+    if(!ext)
+        return;
+    if(ext->lazy)
+        ext->lazy->live--;
+    if(ext->order)
+        List_Order_Unlink(ext->order, node);
+    if(ext->bloom)
+        List_Bloom_Remove(ext->bloom, node->data.name);
+    if(ext->sketch)
+        List_Sketch_Remove(ext->sketch, &node->data);
+    if(ext->aggregate)
+        List_Aggregate_Remove(ext->aggregate, &node->data);
+}
+
+/**
+ * @brief Releases at most max dead items of the lazy delete mode
+ * @return Returns the number of released items
+ */
+static size_t reclaim(List_Ext_t* ext, size_t max) {
+    List_Lazy_t* lazy = ext->lazy;
+    size_t count = 0;
+
+    while(lazy->dead && count < max) {
+        List_Node_t* node = lazy->dead;
+
+        lazy->dead = node->next;
+        node_free(ext, node);
+        count++;
+    }
+    lazy->deadCount -= count;
+    return count;
+}
+
+/**
+ * @brief Releases an unlinked item, or keeps it for List_Reclaim in the lazy
+ * delete mode
+ */
+static void node_release(List_Ext_t* ext, List_Node_t* node) {
+    List_Lazy_t* lazy = ext ? ext->lazy : NULL;
+
+    if(!lazy) {
+        node_free(ext, node);
+        return;
+    }
+    node->next = lazy->dead;
+    lazy->dead = node;
+    lazy->deadCount++;
+    /* a few items per delete, so that no delete pays for all of them */
+    if(lazy->ratio > 0 && lazy->deadCount >= LIST_RECLAIM_MIN &&
+       (double)lazy->deadCount > lazy->ratio * (double)lazy->live)
+        reclaim(ext, LIST_RECLAIM_STEP);
+}
+
+/**
+ * @brief Unlinks and releases the item *link of a list with attachments.
+ * Kept out of List_Delete_First and List_Post_Delete, whose plain list path
+ * is slower with the registers this one needs.
+ */
+static LIST_NOINLINE void node_delete(List_t* const list, List_Node_t** link) {
+    List_Ext_t* ext = list->ext;
+    List_Node_t* late = *link;
+
+    node_unlinked(list, ext, late);
+    *link = late->next;
+    node_release(ext, late);
+}
+
+/**
+ * @brief Detaches the index of the list for a relinking operation
+ * @return Returns true if an index was attached and should be rebuilt
+ */
+static bool order_suspend(List_t* const list) {
+    List_Ext_t* ext = list->ext;
+
+    if(!ext || !ext->order)
+        return false;
+    List_Order_Detach(list);
+    return true;
+}
+
+#ifdef LIST_STATS
+/**
+ * @brief Closes the current traversal after List_Succ moved past the last item
+ */
+static void stats_traversal_end(List_Stats_t* stats) {
+    uint64_t steps = __atomic_exchange_n(&stats->currentTraversal, 0, __ATOMIC_RELAXED);
+    uint64_t longest = __atomic_load_n(&stats->longestTraversal, __ATOMIC_RELAXED);
+
+    __atomic_fetch_add(&stats->traversals, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&stats->traversalSteps, steps, __ATOMIC_RELAXED);
+    while(steps > longest &&
+          !__atomic_compare_exchange_n(&stats->longestTraversal, &longest, steps, true,
+                                       __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        ;
+}
+#endif
 
 /* Functions definitions --------------------------------------------------- */
 
@@ -24,30 +238,45 @@ void List_Init(List_t* const list) {
         return;
 
     list->first = list->active = NULL;
+    list->ext = NULL;
+#ifdef LIST_STATS
+    list->stats = NULL;
+#endif
 }
 
-void List_Insert_First(List_t* const list, Data_t data) {
+void List_Free(List_t* const list) {
     if(!list)
         return;
 
-    List_Node_t* newFirst = myMalloc(sizeof(List_Node_t));
-    if(!newFirst)
-        return;
-
-    newFirst->data = data;
-    newFirst->next = list->first;
+    List_Order_Detach(list);
+    List_Bloom_Detach(list);
+    List_Sketch_Detach(list);
+    List_Aggregate_Detach(list);
+    while(list->first)
+        List_Delete_First(list);
+    List_Lazy_Attach(list, NULL, 0);
+    List_Arena_Detach(list);
+    list->active = NULL;
+}
 
-    list->first = newFirst;
+void List_Insert_First(List_t* const list, Data_t data) {
+    if(!list)
+        return;
+    LIST_STAT_ADD(*list, insertFirst, 1);
 
+    List_Insert_After(list, NULL, data);
 }
 
 void List_First(List_t* const list) {
     if(!list)
         return;
+    LIST_STAT_ADD(*list, first, 1);
+    LIST_STAT_SET(*list, currentTraversal, 0);
     list->active = list->first;
 }
 
 bool List_Copy_First(List_t list, Data_t* data) {
+    LIST_STAT_ADD(list, copyFirst, 1);
     if(!data)
         return false;
     if(!list.first)
@@ -59,8 +288,13 @@ bool List_Copy_First(List_t list, Data_t* data) {
 void List_Delete_First(List_t* const list) {
     if(!list)
         return;
+    LIST_STAT_ADD(*list, deleteFirst, 1);
     if(!list->first)
         return;
+    if(list->ext) {
+        node_delete(list, &list->first);
+        return;
+    }
     if(list->first == list->active)
         list->active = NULL;
     List_Node_t* lateNext = list->first->next;
@@ -72,10 +306,15 @@ void List_Delete_First(List_t* const list) {
 void List_Post_Delete(List_t* const list) {
     if(!list)
         return;
-    if(!list->active)
+    LIST_STAT_ADD(*list, postDelete, 1);
+    if(!list->active || !list->active->next) {
+        LIST_STAT_ADD(*list, postDeleteMiss, 1);
         return;
-    if(!list->active->next)
+    }
+    if(list->ext) {
+        node_delete(list, &list->active->next);
         return;
+    }
     List_Node_t* lateNext = list->active->next->next;
     myFree(list->active->next);
     list->active->next = lateNext;
@@ -84,20 +323,47 @@ void List_Post_Delete(List_t* const list) {
 void List_Post_Insert(List_t* const list, Data_t data) {
     if(!list)
         return;
+    LIST_STAT_ADD(*list, postInsert, 1);
     if(!list->active)
         return;
-    List_Node_t* newFirst = myMalloc(sizeof(List_Node_t));
 
-    if(!newFirst)
-        return;
-    newFirst->data = data;
-    newFirst->next = list->active->next;
+    List_Insert_After(list, list->active, data);
+}
 
-    list->active->next = newFirst;
+List_Node_t* List_Insert_After(List_t* const list, List_Node_t* node, Data_t data) {
+    if(!list)
+        return NULL;
+    List_Ext_t* ext = list->ext;
+    List_Node_t* newNode = node_alloc(ext);
+
+    if(!newNode)
+        return NULL;
+    newNode->data = data;
+    link_after(list, ext, node, newNode);
+    return newNode;
 }
 
+List_Node_t* List_Node_Alloc(List_t* const list) {
+    if(!list)
+        return NULL;
+    return node_alloc(list->ext);
+}
+
+void List_Node_Free(List_t* const list, List_Node_t* node) {
+    if(!list)
+        return;
+    node_free(list->ext, node);
+}
+
+void List_Link_After(List_t* const list, List_Node_t* node, List_Node_t* newNode) {
+    if(!list || !newNode)
+        return;
+
+    link_after(list, list->ext, node, newNode);
+}
 
 bool List_Copy(List_t list, Data_t* data) {
+    LIST_STAT_ADD(list, copy, 1);
     if(!data)
         return false;
     if(!list.active)
@@ -110,21 +376,265 @@ bool List_Copy(List_t list, Data_t* data) {
 void List_Actualize(const List_t* const list, Data_t data) {
     if(!list)
         return;
+    LIST_STAT_ADD(*list, actualize, 1);
     if(!list->active)
         return;
 
+    List_Ext_t* ext = list->ext;
+
+    if(ext && ext->bloom) {
+        List_Bloom_Remove(ext->bloom, list->active->data.name);
+        List_Bloom_Add(ext->bloom, data.name);
+    }
+    if(ext && ext->sketch) {
+        List_Sketch_Remove(ext->sketch, &list->active->data);
+        List_Sketch_Add(ext->sketch, &data);
+    }
+    if(ext && ext->aggregate) {
+        List_Aggregate_Remove(ext->aggregate, &list->active->data);
+        List_Aggregate_Add(ext->aggregate, &data);
+    }
     list->active->data = data;
 }
 
 void List_Succ(List_t* const list) {
     if(!list)
         return;
+    LIST_STAT_ADD(*list, succ, 1);
     if(!list->active)
         return;
 
     list->active = list->active->next;
+#ifdef LIST_STATS
+    if(list->stats) {
+        __atomic_fetch_add(&list->stats->currentTraversal, 1, __ATOMIC_RELAXED);
+        if(!list->active)
+            stats_traversal_end(list->stats);
+    }
+#endif
 }
 
 bool List_Is_Active(List_t list) {
+    LIST_STAT_ADD(list, isActive, 1);
     return list.active;
 }
+
+size_t List_Remove_If(List_t* const list, List_Predicate_t predicate, void* context) {
+    List_Node_t** link;
+    size_t count = 0;
+    List_Ext_t* ext;
+    bool indexed;
+
+    if(!list || !predicate)
+        return 0;
+    indexed = order_suspend(list);
+    ext = list->ext;
+
+    link = &list->first;
+    while(*link) {
+        List_Node_t* node = *link;
+
+        if(!predicate(&node->data, context)) {
+            link = &node->next;
+            continue;
+        }
+        *link = node->next;
+        node_unlinked(list, ext, node);
+        node_release(ext, node);
+        count++;
+    }
+
+    if(indexed)
+        List_Order_Attach(list);
+    return count;
+}
+
+void List_Reverse(List_t* const list) {
+    List_Node_t* reversed = NULL;
+    bool indexed;
+
+    if(!list)
+        return;
+    indexed = order_suspend(list);
+
+    while(list->first) {
+        List_Node_t* node = list->first;
+
+        list->first = node->next;
+        node->next = reversed;
+        reversed = node;
+    }
+    list->first = reversed;
+
+    if(indexed)
+        List_Order_Attach(list);
+}
+
+bool List_Split_At_Active(List_t* const list, List_t* const tail) {
+    List_Ext_t *ext, *tailExt;
+    List_Node_t* moved;
+    bool indexed, tailIndexed;
+
+    if(!list || !tail || !list->active || tail->first)
+        return false;
+    ext = list->ext;
+    tailExt = tail->ext;
+    if((ext && ext->arena) || (tailExt && tailExt->arena))
+        return false;
+    moved = list->active->next;
+    list->active->next = NULL;
+    if(!moved)
+        return true;
+    indexed = order_suspend(list);
+    tailIndexed = order_suspend(tail);
+    ext = list->ext;
+    tailExt = tail->ext;
+
+    tail->first = moved;
+    if(ext || tailExt) {
+        for(List_Node_t* node = moved; node; node = node->next) {
+            node_unlinked(list, ext, node);
+            if(tailExt)
+                node_linked(tailExt, node);
+        }
+    }
+
+    if(indexed)
+        List_Order_Attach(list);
+    if(tailIndexed)
+        List_Order_Attach(tail);
+    return true;
+}
+
+size_t List_Partition(List_t* const list, List_Predicate_t predicate, void* context) {
+    List_Node_t* rejected = NULL;
+    List_Node_t** keptLink;
+    List_Node_t** rejectedLink = &rejected;
+    size_t count = 0;
+    bool indexed;
+
+    if(!list || !predicate)
+        return 0;
+    indexed = order_suspend(list);
+
+    keptLink = &list->first;
+    for(List_Node_t* node = list->first; node; node = node->next) {
+        if(predicate(&node->data, context)) {
+            *keptLink = node;
+            keptLink = &node->next;
+            count++;
+        } else {
+            *rejectedLink = node;
+            rejectedLink = &node->next;
+        }
+    }
+    *rejectedLink = NULL;
+    *keptLink = rejected;
+
+    if(indexed)
+        List_Order_Attach(list);
+    return count;
+}
+
+bool List_Lazy_Attach(List_t* const list, List_Lazy_t* lazy, double ratio) {
+    List_Ext_t* ext;
+
+    if(!list || ratio < 0)
+        return false;
+    List_Reclaim(list);
+
+    if(!lazy) {
+        ext = list->ext;
+        if(ext) {
+            ext->lazy = NULL;
+            List_Ext_Release(list);
+        }
+        return true;
+    }
+    ext = List_Ext_Get(list);
+    if(!ext)
+        return false;
+    memset(lazy, 0, sizeof(*lazy));
+    lazy->ratio = ratio;
+    for(const List_Node_t* node = list->first; node; node = node->next)
+        lazy->live++;
+    ext->lazy = lazy;
+    return true;
+}
+
+size_t List_Reclaim(List_t* const list) {
+    List_Ext_t* ext;
+
+    if(!list)
+        return 0;
+    ext = list->ext;
+    if(!ext || !ext->lazy)
+        return 0;
+    return reclaim(ext, (size_t)-1);
+}
+
+bool List_Dump(List_t list, int fd) {
+    char* buffer = malloc(LIST_DUMP_BUFFER);
+    size_t used = 0;
+    bool ok = true;
+
+    if(!buffer)
+        return false;
+
+    for(List_Node_t* node = list.first; node && ok; node = node->next) {
+        if(LIST_DUMP_BUFFER - used < DATA_FORMAT_MAX) {
+            ok = write_all(fd, buffer, used);
+            used = 0;
+        }
+        used += Data_Format(&node->data, buffer + used);
+    }
+    if(ok)
+        ok = write_all(fd, buffer, used);
+
+    free(buffer);
+    return ok;
+}
+
+bool List_Stats_Attach(List_t* const list, List_Stats_t* stats) {
+#ifdef LIST_STATS
+    if(!list)
+        return false;
+    if(stats)
+        memset(stats, 0, sizeof(*stats));
+    list->stats = stats;
+    return true;
+#else
+    (void)list;
+    (void)stats;
+    return false;
+#endif
+}
+
+bool List_Get_Stats(List_t list, List_Stats_t* stats) {
+    if(!stats)
+        return false;
+    memset(stats, 0, sizeof(*stats));
+#ifdef LIST_STATS
+    if(!list.stats)
+        return false;
+    stats->insertFirst = __atomic_load_n(&list.stats->insertFirst, __ATOMIC_RELAXED);
+    stats->first = __atomic_load_n(&list.stats->first, __ATOMIC_RELAXED);
+    stats->copyFirst = __atomic_load_n(&list.stats->copyFirst, __ATOMIC_RELAXED);
+    stats->deleteFirst = __atomic_load_n(&list.stats->deleteFirst, __ATOMIC_RELAXED);
+    stats->postDelete = __atomic_load_n(&list.stats->postDelete, __ATOMIC_RELAXED);
+    stats->postDeleteMiss = __atomic_load_n(&list.stats->postDeleteMiss, __ATOMIC_RELAXED);
+    stats->postInsert = __atomic_load_n(&list.stats->postInsert, __ATOMIC_RELAXED);
+    stats->copy = __atomic_load_n(&list.stats->copy, __ATOMIC_RELAXED);
+    stats->actualize = __atomic_load_n(&list.stats->actualize, __ATOMIC_RELAXED);
+    stats->succ = __atomic_load_n(&list.stats->succ, __ATOMIC_RELAXED);
+    stats->isActive = __atomic_load_n(&list.stats->isActive, __ATOMIC_RELAXED);
+    stats->traversals = __atomic_load_n(&list.stats->traversals, __ATOMIC_RELAXED);
+    stats->traversalSteps = __atomic_load_n(&list.stats->traversalSteps, __ATOMIC_RELAXED);
+    stats->longestTraversal = __atomic_load_n(&list.stats->longestTraversal, __ATOMIC_RELAXED);
+    stats->currentTraversal = __atomic_load_n(&list.stats->currentTraversal, __ATOMIC_RELAXED);
+    return true;
+#else
+    (void)list;
+    return false;
+#endif
+}
@@ -12,6 +12,7 @@
 
 /* Public includes --------------------------------------------------------- */
 #include <stdbool.h>
+#include <stdint.h>
 #include "data.h"
 #include "mymalloc.h"
 
@@ -28,22 +29,100 @@ typedef struct List_Node_s {
 
 typedef List_Node_t* List_Node_Ptr_t;
 
+/** @struct List_Stats_t
+ * Operation counters of one list, collected only when the library is built
+ * with LIST_STATS. A traversal is counted from List_First until List_Succ
+ * moves past the last item, its length is the number of List_Succ steps
+ * (the number of items visited).
+ */
+typedef struct {
+  uint64_t insertFirst;      /**< List_Insert_First calls */
+  uint64_t first;            /**< List_First calls */
+  uint64_t copyFirst;        /**< List_Copy_First calls */
+  uint64_t deleteFirst;      /**< List_Delete_First calls */
+  uint64_t postDelete;       /**< List_Post_Delete calls */
+  uint64_t postDeleteMiss;   /**< List_Post_Delete calls deleting nothing */
+  uint64_t postInsert;       /**< List_Post_Insert calls */
+  uint64_t copy;             /**< List_Copy calls */
+  uint64_t actualize;        /**< List_Actualize calls */
+  uint64_t succ;             /**< List_Succ calls */
+  uint64_t isActive;         /**< List_Is_Active calls */
+  uint64_t traversals;       /**< completed traversals */
+  uint64_t traversalSteps;   /**< List_Succ steps of completed traversals */
+  uint64_t longestTraversal; /**< steps of the longest traversal */
+  uint64_t currentTraversal; /**< steps since the last List_First */
+} List_Stats_t;
+
+/**
+ * @brief Condition on the data of an item
+ * @param data[in] - data of the item
+ * @param context[in] - context passed along with the predicate
+ * @return Returns true if the item satisfies the condition
+ */
+typedef bool (*List_Predicate_t)(const Data_t* data, void* context);
+
+/** @struct List_Lazy_t
+ * State of the lazy delete mode of one list (List_Lazy_Attach). Deleted
+ * items are unlinked at once but released only by List_Reclaim.
+ */
+typedef struct {
+  List_Node_t* dead; /**< deleted items waiting for List_Reclaim */
+  size_t deadCount;  /**< number of deleted items waiting */
+  size_t live;       /**< number of items in the list */
+  double ratio;      /**< deadCount / live above which deletes reclaim */
+} List_Lazy_t;
+
+/** Order-statistic index of a list, see order.h */
+typedef struct List_Order_s List_Order_t;
+
+/** Counting Bloom filter of the names in a list, see bloom.h */
+typedef struct List_Bloom_s List_Bloom_t;
+
+/** Node arena of a list, see arena.h */
+typedef struct List_Arena_s List_Arena_t;
+
+/** Quantile sketches of the numeric fields of a list, see sketch.h */
+typedef struct List_Sketch_s List_Sketch_t;
+
+/** Running sums of the numeric fields of a list, see aggregate.h */
+typedef struct List_Aggregate_s List_Aggregate_t;
+
+/** Attachments of a list, see list_ext.h */
+typedef struct List_Ext_s List_Ext_t;
+
 /** @struct List_t
  * Definition of list as a pointer at first and active item.
  *
+ * Index, filter, lazy delete state, arena, sketches and sums attached at run
+ * time are kept in one block owned by the list (list_ext.h), which a copy of
+ * the struct shares. List_Free releases them. The member ext sits between
+ * first and active, so a copy of the struct passed by value reads active on
+ * its own and not together with first right after List_Succ stored it.
  */
 typedef struct {
   List_Node_t* first;  /**< Pointer at first item in list */
+  List_Ext_t* ext;     /**< Attachments of the list or NULL */
   List_Node_t* active; /**< Pointer at active item in list */
+#ifdef LIST_STATS
+  List_Stats_t* stats; /**< Counters attached by List_Stats_Attach or NULL */
+#endif
 } List_t;
 
 /* Public List_t API ------------------------------------------------------- */
 /**
  * @brief       Initializes the list, set List_t#first list->first &
- * List_t#active list->active with NULL pointers
+ * List_t#active list->active with NULL pointers. Attachments of the list are
+ * forgotten without being released, use List_Free for that.
  * @param[in]   list    List, which we want to initialize
  */
 void List_Init(List_t* const list);
+
+/**
+ * @brief Deletes all items of the list and releases its attachments, the
+ * list is empty and plain afterwards
+ * @param list[in] - list, with which the operation should be done
+ */
+void List_Free(List_t* const list);
 //
 /**
  * @brief Creates a new item and puts it at the start of the list, active item
@@ -91,6 +170,47 @@ void List_Post_Delete(List_t* const list);
  */
 void List_Post_Insert(List_t* const list, Data_t data);
 
+/**
+ * @brief Creates a new item and links it after the given item, or puts it at
+ * the start of the list when node is NULL. Active item stays the same. Bulk
+ * loaders use the returned item to append records in O(1) each.
+ * @param list[in] - list, with which the operation should be done
+ * @param node[in] - item of the list, after which the new item is linked
+ * @param data[in] - data to store in a list
+ * @return Returns pointer at the new item, NULL if it could not be allocated
+ */
+List_Node_t* List_Insert_After(List_t* const list, List_Node_t* node,
+                               Data_t data);
+
+/**
+ * @brief Allocates a new item for the list without linking it, from the arena
+ * of the list if it has one (arena.h). The data part is left uninitialized,
+ * so a loader can parse straight into it and then link the item with
+ * List_Link_After.
+ * @param list[in] - list, for which the item is allocated
+ * @return Returns pointer at the new item, NULL if it could not be allocated
+ */
+List_Node_t* List_Node_Alloc(List_t* const list);
+
+/**
+ * @brief Releases an item allocated by List_Node_Alloc that was never linked
+ * into the list.
+ * @param list[in] - list, for which the item was allocated
+ * @param node[in] - item to release
+ */
+void List_Node_Free(List_t* const list, List_Node_t* node);
+
+/**
+ * @brief Links an item allocated by List_Node_Alloc after the given item, or
+ * puts it at the start of the list when node is NULL. Active item stays the
+ * same.
+ * @param list[in] - list, with which the operation should be done
+ * @param node[in] - item of the list, after which the new item is linked
+ * @param newNode[in] - item to link
+ */
+void List_Link_After(List_t* const list, List_Node_t* node,
+                     List_Node_t* newNode);
+
 /**
  * @brief Return the data from an active item
  * @param list[in] - list, with which the operation should be done
@@ -120,4 +240,113 @@ void List_Succ(List_t* const list);
  */
 bool List_Is_Active(List_t list);
 
+/**
+ * @brief Unlinks all items satisfying the predicate in one pass over the
+ * list, releasing each as soon as it is unlinked. If the active item is
+ * removed, the list has no active item afterwards. An attached
+ * order-statistic index is rebuilt once instead of being updated per item.
+ * @param list[in] - list, with which the operation should be done
+ * @param predicate[in] - condition selecting the items to remove
+ * @param context[in] - passed to the predicate
+ * @return Returns the number of removed items
+ */
+size_t List_Remove_If(List_t* const list, List_Predicate_t predicate,
+                      void* context);
+
+/**
+ * @brief Reverses the order of the items by relinking them, no item is
+ * allocated or copied. The active item stays the same. An attached
+ * order-statistic index is rebuilt.
+ * @param list[in] - list, with which the operation should be done
+ */
+void List_Reverse(List_t* const list);
+
+/**
+ * @brief Moves all items after the active item, in their order, into an
+ * empty list by relinking them; the active item becomes the last one of the
+ * list. The attachments of both lists are updated, which visits the moved
+ * items once if a filter, sketch, aggregate, index or lazy delete state is
+ * attached. Lists with
+ * a node arena can not be split, as their items must go back to the arena
+ * they came from.
+ * @param list[in] - list, with which the operation should be done
+ * @param tail[out] - initialized empty list receiving the items
+ * @return Returns false if there is no active item, tail is not empty or
+ * either list has a node arena
+ */
+bool List_Split_At_Active(List_t* const list, List_t* const tail);
+
+/**
+ * @brief Stable partition: relinks the items satisfying the predicate in
+ * front of the others, keeping the order within both groups, without
+ * allocating or copying an item. The active item stays the same. An attached
+ * order-statistic index is rebuilt.
+ * @param list[in] - list, with which the operation should be done
+ * @param predicate[in] - condition selecting the items to move to the front
+ * @param context[in] - passed to the predicate
+ * @return Returns the number of items satisfying the predicate
+ */
+size_t List_Partition(List_t* const list, List_Predicate_t predicate,
+                      void* context);
+
+/**
+ * @brief Switches the list to the lazy delete mode: deleted items are
+ * unlinked as usual, so traversals never see them, but instead of being
+ * released they are kept on a list of dead items, which makes every delete
+ * O(1) without a call to the allocator. The dead items are released in one
+ * batch by List_Reclaim. Once at least 64 items are dead and more than ratio
+ * times the number of items in the list, every further delete also releases
+ * up to 4 dead items, so the dead items stay bounded and no delete costs
+ * more than a few calls to the allocator. The storage must outlive its use
+ * by the list; List_Free releases the dead items and switches the mode off.
+ * @param list[in] - list, with which the operation should be done
+ * @param lazy[in] - storage of the lazy delete state, NULL releases the dead
+ * items and switches back to immediate deletes
+ * @param ratio[in] - dead to live ratio above which deletes release dead
+ * items, 0 releases them only in List_Reclaim
+ * @return Returns false for a negative ratio or when out of memory
+ */
+bool List_Lazy_Attach(List_t* const list, List_Lazy_t* lazy, double ratio);
+
+/**
+ * @brief Releases all dead items of the lazy delete mode in one batch
+ * @param list[in] - list, with which the operation should be done
+ * @return Returns the number of released items
+ */
+size_t List_Reclaim(List_t* const list);
+
+/**
+ * @brief Writes all items of the list to a file descriptor in the format of
+ * Data_Print, one item per line. Items are formatted into a large buffer
+ * without printf and the buffer is written by one write() call when full.
+ * Flush any stdio stream using the same descriptor before calling.
+ * @param list[in] - list, with which the operation should be done
+ * @param fd[in] - descriptor, where the items are written
+ * @return Returns false if writing failed
+ */
+bool List_Dump(List_t list, int fd);
+
+/**
+ * @brief Attaches storage for the operation counters of the list and zeroes
+ * it. The counters are updated with relaxed atomic increments, the storage
+ * must outlive its use by the list. List_Init detaches the counters.
+ * Without LIST_STATS the call does nothing and the list operations contain
+ * no counting code at all.
+ * @param list[in] - list, whose operations should be counted
+ * @param stats[in] - storage of the counters, NULL detaches them
+ * @return Returns false if the library was built without LIST_STATS
+ */
+bool List_Stats_Attach(List_t* const list, List_Stats_t* stats);
+
+/**
+ * @brief Takes a snapshot of the counters of the list. Every counter is read
+ * atomically, but the snapshot as a whole is not taken at one instant while
+ * other threads use the list.
+ * @param list[in] - list, whose counters should be read
+ * @param stats[out] - snapshot of the counters, zeroed if none are attached
+ * @return Returns false if no counters are attached or the library was
+ * built without LIST_STATS
+ */
+bool List_Get_Stats(List_t list, List_Stats_t* stats);
+
 #endif /* LIST_H */
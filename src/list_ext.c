@@ -0,0 +1,32 @@
+/**
+ * @file       list_ext.c
+ * @date       10/2026
+ * @brief      Optional attachments of a linear list
+ * ****************************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ */
+
+/* Private includes -------------------------------------------------------- */
+#include "list_ext.h"
+
+#include <stdlib.h>
+
+/* Functions definitions --------------------------------------------------- */
+
+List_Ext_t* List_Ext_Get(List_t* const list) {
+    if(!list)
+        return NULL;
+    if(!list->ext)
+        list->ext = calloc(1, sizeof(List_Ext_t));
+    return list->ext;
+}
+
+void List_Ext_Release(List_t* const list) {
+    List_Ext_t* ext = list ? list->ext : NULL;
+
+    if(!ext || ext->order || ext->bloom || ext->lazy || ext->arena || ext->sketch ||
+       ext->aggregate)
+        return;
+    free(ext);
+    list->ext = NULL;
+}
@@ -0,0 +1,48 @@
+/**
+ * @file       list_ext.h
+ * @date       10/2026
+ * @brief      Optional attachments of a linear list
+ * **********************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * Everything attached to a list at run time (index, filter, lazy delete
+ * state, arena, sketches, sums) lives in one List_Ext_t owned by the list
+ * through List_t#ext, so a plain list carries a single NULL pointer for all
+ * of them. The block is allocated by the first attach and freed when the
+ * last attachment is detached, at the latest by List_Free.
+ *
+ * The block is internal to the library; it is used by list.c and by the
+ * attach and query functions of the modules.
+ */
+
+#ifndef LIST_EXT_H
+#define LIST_EXT_H
+
+/* Public includes --------------------------------------------------------- */
+#include "list.h"
+
+/** @struct List_Ext_s
+ * Attachments of one list, a NULL member is not attached
+ */
+struct List_Ext_s {
+  List_Order_t* order;         /**< index attached by List_Order_Attach */
+  List_Bloom_t* bloom;         /**< filter attached by List_Bloom_Attach */
+  List_Lazy_t* lazy;           /**< state set by List_Lazy_Attach */
+  List_Arena_t* arena;         /**< arena attached by List_Arena_Attach */
+  List_Sketch_t* sketch;       /**< sketches attached by List_Sketch_Attach */
+  List_Aggregate_t* aggregate; /**< sums attached by List_Aggregate_Attach */
+};
+
+/**
+ * @brief Returns the attachments of the list, allocating an empty block if
+ * it has none yet
+ * @return Returns NULL if the memory could not be allocated
+ */
+List_Ext_t* List_Ext_Get(List_t* const list);
+
+/**
+ * @brief Frees the attachment block of the list once nothing is attached
+ */
+void List_Ext_Release(List_t* const list);
+
+#endif /* LIST_EXT_H */
@@ -0,0 +1,145 @@
+/**
+ * @file       loader.c
+ * @date       10/2026
+ * @brief      Bulk loading of records from text files into a linear list
+ * ****************************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ */
+
+#if !defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 200809L
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+/* Private includes -------------------------------------------------------- */
+#include "loader.h"
+
+#include <string.h>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <stdio.h>
+#include <stdlib.h>
+#endif
+
+/* Private functions ------------------------------------------------------- */
+
+static bool only_blanks(const char* p, const char* end) {
+    for(; p < end; p++)
+        if(*p != ' ' && *p != '\t' && *p != '\r' && *p != '\n')
+            return false;
+    return true;
+}
+
+/* Functions definitions --------------------------------------------------- */
+
+bool List_Load_Buffer(List_t* const list, const char* text, size_t length,
+                      size_t* count) {
+    const char* p = text;
+    const char* end = text + length;
+    List_Node_t* last = NULL;
+    size_t loaded = 0;
+    bool ok = true;
+
+    if(count)
+        *count = 0;
+    if(!list || (!text && length))
+        return false;
+
+    while(p < end && !only_blanks(p, end)) {
+        /* parse straight into the item, only the used part of the name and
+         * the numbers are written */
+        List_Node_t* node = List_Node_Alloc(list);
+
+        if(!node) {
+            ok = false;
+            break;
+        }
+        if(!Data_Parse(&p, end, &node->data)) {
+            List_Node_Free(list, node);
+            ok = false;
+            break;
+        }
+
+        List_Link_After(list, last, node);
+        last = node;
+        loaded++;
+    }
+
+    if(count)
+        *count = loaded;
+    return ok;
+}
+
+#ifdef __linux__
+
+bool List_Load_Text(List_t* const list, const char* path, size_t* count) {
+    struct stat st;
+    void* map;
+    bool ok;
+    int fd;
+
+    if(count)
+        *count = 0;
+    if(!list || !path)
+        return false;
+
+    fd = open(path, O_RDONLY);
+    if(fd < 0)
+        return false;
+    if(fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+    if(st.st_size == 0) {
+        close(fd);
+        return true;
+    }
+
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(map == MAP_FAILED)
+        return false;
+
+    posix_madvise(map, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+    ok = List_Load_Buffer(list, map, (size_t)st.st_size, count);
+    munmap(map, (size_t)st.st_size);
+    return ok;
+}
+
+#else /* !__linux__ */
+
+bool List_Load_Text(List_t* const list, const char* path, size_t* count) {
+    FILE* file;
+    char* text;
+    long length;
+    bool ok;
+
+    if(count)
+        *count = 0;
+    if(!list || !path)
+        return false;
+
+    /* no mmap, the file is read into memory as a whole */
+    file = fopen(path, "rb");
+    if(!file)
+        return false;
+    if(fseek(file, 0, SEEK_END) != 0 || (length = ftell(file)) < 0 ||
+       fseek(file, 0, SEEK_SET) != 0) {
+        fclose(file);
+        return false;
+    }
+    text = malloc(length ? (size_t)length : 1);
+    ok = text && fread(text, 1, (size_t)length, file) == (size_t)length;
+    fclose(file);
+    if(ok)
+        ok = List_Load_Buffer(list, text, (size_t)length, count);
+    free(text);
+    return ok;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,64 @@
+/**
+ * @file       loader.h
+ * @date       10/2026
+ * @brief      Bulk loading of records from text files into a linear list
+ * **********************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ */
+
+#ifndef LOADER_H
+#define LOADER_H
+
+/* Public includes --------------------------------------------------------- */
+#include <stdbool.h>
+#include <stddef.h>
+#include "list.h"
+
+/* Public loader API ------------------------------------------------------- */
+/**
+ * @brief Loads records from a text file in the same format Data_Get reads
+ * them: name, age, weight and height, each on its own line. The file is
+ * mapped into memory (read into it without mmap outside Linux) and parsed
+ * in one pass without stdio. Loaded records are
+ * put at the start of the list in the order of the file, active item stays
+ * the same.
+ * @param list[in] - list, where to store the loaded items
+ * @param path[in] - path of the record file
+ * @param count[out] - if not NULL, receives number of loaded records
+ * @return Returns false if the file could not be read, a record is malformed
+ * or an item could not be allocated. Records loaded before the error stay in
+ * the list.
+ */
+bool List_Load_Text(List_t* const list, const char* path, size_t* count);
+
+/**
+ * @brief Parses records in the List_Load_Text format from a memory buffer.
+ * @param list[in] - list, where to store the loaded items
+ * @param text[in] - records in text form, doesn't have to be terminated
+ * @param length[in] - length of the text in bytes
+ * @param count[out] - if not NULL, receives number of loaded records
+ * @return Returns false if a record is malformed or an item could not be
+ * allocated
+ */
+bool List_Load_Buffer(List_t* const list, const char* text, size_t length,
+                      size_t* count);
+
+/**
+ * @brief Loads a record file like List_Load_Text, but as a pipeline: a reader
+ * thread reads the file in blocks cut at record boundaries, parser threads
+ * turn the blocks into records and the calling thread links them into the
+ * list in the order of the file. Reading, parsing and linking overlap. A
+ * record longer than 1 MiB is reported as malformed, so memory stays bounded
+ * whatever the file. Outside Linux the file is loaded by List_Load_Text.
+ * @param list[in] - list, where to store the loaded items
+ * @param path[in] - path of the record file
+ * @param workers[in] - number of parser threads, 0 for one per spare CPU
+ * @param count[out] - if not NULL, receives number of loaded records
+ * @return Returns false if the file could not be read, a record is malformed
+ * or an item could not be allocated. Records loaded before the error stay in
+ * the list.
+ */
+bool List_Load_Text_Parallel(List_t* const list, const char* path, int workers,
+                             size_t* count);
+
+#endif /* LOADER_H */
@@ -0,0 +1,453 @@
+/**
+ * @file       loader_mt.c
+ * @date       10/2026
+ * @brief      Pipelined multi-threaded loading of record files
+ * ****************************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * The pipeline has three stages connected by bounded lock-free queues:
+ *
+ *   reader thread  --chunks-->  N parser threads  --batches-->  builder
+ *
+ * The reader reads the file in large blocks and cuts them at record
+ * boundaries (every fourth line break). Parsers turn a chunk into an array of
+ * Data_t. The builder (the calling thread) links the batches into the list in
+ * the original order; batches that arrive early wait in a reorder window. The
+ * reader never runs more than the window ahead of the builder, so neither
+ * queue can overflow and memory use stays bounded.
+ */
+
+#if !defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 200809L
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+/* Private includes -------------------------------------------------------- */
+#include "loader.h"
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Private constants ------------------------------------------------------- */
+/** Size of one block read from the file */
+#define PIPELINE_CHUNK_SIZE (1u << 20)
+/** Most chunks in flight between the reader and the builder, power of two */
+#define PIPELINE_WINDOW 16u
+#define PIPELINE_MAX_WORKERS 64
+/** Longest incomplete record carried over to the next block */
+#define PIPELINE_MAX_CARRY PIPELINE_CHUNK_SIZE
+#define LINES_PER_RECORD 4
+
+/* Private types ----------------------------------------------------------- */
+typedef struct {
+    uint64_t seq;
+    char* text;       /**< chunk text, freed by the parser */
+    size_t length;
+    size_t records;   /**< number of records in the chunk */
+    Data_t* batch;    /**< parsed records, freed by the builder */
+    size_t parsed;    /**< records parsed before an error */
+    bool ok;
+} Pipeline_Chunk_t;
+
+/** Cell of the bounded multi-producer multi-consumer queue (D. Vyukov) */
+typedef struct {
+    uint64_t sequence;
+    Pipeline_Chunk_t* chunk;
+} Pipeline_Cell_t;
+
+typedef struct {
+    Pipeline_Cell_t cells[PIPELINE_WINDOW];
+    char pad0[64];
+    uint64_t head;
+    char pad1[64];
+    uint64_t tail;
+} Pipeline_Queue_t;
+
+typedef struct {
+    int fd;
+    Pipeline_Queue_t chunks;   /**< reader -> parsers */
+    Pipeline_Queue_t batches;  /**< parsers -> builder */
+    uint64_t consumed;         /**< chunks linked by the builder */
+    uint64_t total;            /**< chunks produced, valid once readerDone */
+    int readerDone;
+    int readError;
+    int stop;                  /**< builder gave up, drain everything */
+} Pipeline_t;
+
+/* Private functions ------------------------------------------------------- */
+
+static void queue_init(Pipeline_Queue_t* q) {
+    memset(q, 0, sizeof(*q));
+    for(uint64_t i = 0; i < PIPELINE_WINDOW; i++)
+        q->cells[i].sequence = i;
+}
+
+static bool queue_try_push(Pipeline_Queue_t* q, Pipeline_Chunk_t* chunk) {
+    uint64_t pos = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+
+    for(;;) {
+        Pipeline_Cell_t* cell = &q->cells[pos & (PIPELINE_WINDOW - 1)];
+        uint64_t seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        int64_t diff = (int64_t)(seq - pos);
+
+        if(diff == 0) {
+            if(__atomic_compare_exchange_n(&q->tail, &pos, pos + 1, true,
+                                           __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                cell->chunk = chunk;
+                __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+                return true;
+            }
+        } else if(diff < 0) {
+            return false;
+        } else {
+            pos = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static Pipeline_Chunk_t* queue_try_pop(Pipeline_Queue_t* q) {
+    uint64_t pos = __atomic_load_n(&q->head, __ATOMIC_RELAXED);
+
+    for(;;) {
+        Pipeline_Cell_t* cell = &q->cells[pos & (PIPELINE_WINDOW - 1)];
+        uint64_t seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        int64_t diff = (int64_t)(seq - (pos + 1));
+
+        if(diff == 0) {
+            if(__atomic_compare_exchange_n(&q->head, &pos, pos + 1, true,
+                                           __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                Pipeline_Chunk_t* chunk = cell->chunk;
+                __atomic_store_n(&cell->sequence, pos + PIPELINE_WINDOW,
+                                 __ATOMIC_RELEASE);
+                return chunk;
+            }
+        } else if(diff < 0) {
+            return NULL;
+        } else {
+            pos = __atomic_load_n(&q->head, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static void queue_push(Pipeline_Queue_t* q, Pipeline_Chunk_t* chunk) {
+    while(!queue_try_push(q, chunk))
+        sched_yield();
+}
+
+static void chunk_free(Pipeline_Chunk_t* chunk) {
+    free(chunk->text);
+    free(chunk->batch);
+    free(chunk);
+}
+
+static ssize_t read_full(int fd, char* buffer, size_t size) {
+    size_t got = 0;
+
+    while(got < size) {
+        ssize_t n = read(fd, buffer + got, size - got);
+        if(n < 0 && errno == EINTR)
+            continue;
+        if(n < 0)
+            return -1;
+        if(n == 0)
+            break;
+        got += (size_t)n;
+    }
+    return (ssize_t)got;
+}
+
+/**
+ * @brief Returns length of the longest prefix of text made of whole records
+ * and the number of records in it
+ */
+static size_t cut_records(const char* text, size_t length, size_t* records) {
+    const char* p = text;
+    const char* end = text + length;
+    size_t lines = 0;
+    size_t cut = 0;
+
+    while(p < end) {
+        const char* nl = memchr(p, '\n', (size_t)(end - p));
+        if(!nl)
+            break;
+        p = nl + 1;
+        if(++lines % LINES_PER_RECORD == 0)
+            cut = (size_t)(p - text);
+    }
+    *records = lines / LINES_PER_RECORD;
+    return cut;
+}
+
+static Pipeline_Chunk_t* chunk_new(uint64_t seq, char* text, size_t length,
+                                   size_t records) {
+    Pipeline_Chunk_t* chunk = calloc(1, sizeof(*chunk));
+    if(!chunk)
+        return NULL;
+    chunk->seq = seq;
+    chunk->text = text;
+    chunk->length = length;
+    chunk->records = records;
+    return chunk;
+}
+
+static void* reader_main(void* arg) {
+    Pipeline_t* pipeline = arg;
+    char* carry = NULL;
+    size_t carryLength = 0;
+    uint64_t seq = 0;
+    bool eof = false;
+
+    while(!eof && !__atomic_load_n(&pipeline->stop, __ATOMIC_ACQUIRE)) {
+        size_t capacity = carryLength + PIPELINE_CHUNK_SIZE;
+        char* text = malloc(capacity + 1);
+        Pipeline_Chunk_t* chunk;
+        size_t length, cut, records;
+        ssize_t got;
+
+        if(!text) {
+            __atomic_store_n(&pipeline->readError, 1, __ATOMIC_RELEASE);
+            break;
+        }
+        if(carryLength)
+            memcpy(text, carry, carryLength);
+        free(carry);
+        carry = NULL;
+
+        got = read_full(pipeline->fd, text + carryLength, PIPELINE_CHUNK_SIZE);
+        if(got < 0) {
+            free(text);
+            __atomic_store_n(&pipeline->readError, 1, __ATOMIC_RELEASE);
+            break;
+        }
+        length = carryLength + (size_t)got;
+        eof = (size_t)got < PIPELINE_CHUNK_SIZE;
+
+        if(eof) {
+            /* the last record may miss its final line break */
+            text[length] = '\n';
+            cut = cut_records(text, length + 1, &records);
+            if(cut > length)
+                cut = length;
+        } else {
+            cut = cut_records(text, length, &records);
+        }
+
+        carryLength = length - cut;
+        if(carryLength > PIPELINE_MAX_CARRY) {
+            /* no record is that long, the file is not a record file */
+            free(text);
+            carryLength = 0;
+            __atomic_store_n(&pipeline->readError, 1, __ATOMIC_RELEASE);
+            break;
+        }
+        if(carryLength) {
+            carry = malloc(carryLength);
+            if(!carry) {
+                free(text);
+                __atomic_store_n(&pipeline->readError, 1, __ATOMIC_RELEASE);
+                break;
+            }
+            memcpy(carry, text + cut, carryLength);
+        }
+
+        if(!records) {
+            free(text);
+            continue;
+        }
+        chunk = chunk_new(seq, text, cut, records);
+        if(!chunk) {
+            free(text);
+            __atomic_store_n(&pipeline->readError, 1, __ATOMIC_RELEASE);
+            break;
+        }
+
+        /* stay within the reorder window of the builder */
+        while(seq - __atomic_load_n(&pipeline->consumed, __ATOMIC_ACQUIRE) >=
+              PIPELINE_WINDOW && !__atomic_load_n(&pipeline->stop, __ATOMIC_ACQUIRE))
+            sched_yield();
+        if(__atomic_load_n(&pipeline->stop, __ATOMIC_ACQUIRE)) {
+            free(chunk->text);
+            free(chunk);
+            break;
+        }
+        queue_push(&pipeline->chunks, chunk);
+        seq++;
+    }
+
+    /* leftover that is not a whole record (only blank lines are fine) */
+    for(size_t i = 0; i < carryLength; i++) {
+        char c = carry[i];
+        if(c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+            __atomic_store_n(&pipeline->readError, 1, __ATOMIC_RELEASE);
+            break;
+        }
+    }
+    free(carry);
+
+    __atomic_store_n(&pipeline->total, seq, __ATOMIC_RELEASE);
+    __atomic_store_n(&pipeline->readerDone, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void* parser_main(void* arg) {
+    Pipeline_t* pipeline = arg;
+
+    for(;;) {
+        Pipeline_Chunk_t* chunk = queue_try_pop(&pipeline->chunks);
+
+        if(!chunk) {
+            if(__atomic_load_n(&pipeline->readerDone, __ATOMIC_ACQUIRE) &&
+               __atomic_load_n(&pipeline->chunks.head, __ATOMIC_ACQUIRE) >=
+               __atomic_load_n(&pipeline->total, __ATOMIC_ACQUIRE))
+                break;
+            sched_yield();
+            continue;
+        }
+
+        chunk->batch = malloc(chunk->records * sizeof(Data_t));
+        chunk->ok = chunk->batch != NULL;
+        if(chunk->ok && !__atomic_load_n(&pipeline->stop, __ATOMIC_ACQUIRE)) {
+            const char* p = chunk->text;
+            const char* end = chunk->text + chunk->length;
+            while(chunk->parsed < chunk->records &&
+                  Data_Parse(&p, end, &chunk->batch[chunk->parsed]))
+                chunk->parsed++;
+            chunk->ok = chunk->parsed == chunk->records;
+        }
+        free(chunk->text);
+        chunk->text = NULL;
+        queue_push(&pipeline->batches, chunk);
+    }
+    return NULL;
+}
+
+/* Functions definitions --------------------------------------------------- */
+
+bool List_Load_Text_Parallel(List_t* const list, const char* path, int workers,
+                             size_t* count) {
+    Pipeline_Chunk_t* window[PIPELINE_WINDOW] = {NULL};
+    pthread_t parsers[PIPELINE_MAX_WORKERS];
+    pthread_t reader;
+    Pipeline_t* pipeline;
+    List_Node_t* last = NULL;
+    size_t loaded = 0;
+    int started = 0;
+    bool ok = true;
+
+    if(count)
+        *count = 0;
+    if(!list || !path)
+        return false;
+    if(workers <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = cpus > 1 ? (int)cpus - 1 : 1;
+    }
+    if(workers > PIPELINE_MAX_WORKERS)
+        workers = PIPELINE_MAX_WORKERS;
+
+    pipeline = calloc(1, sizeof(*pipeline));
+    if(!pipeline)
+        return false;
+    queue_init(&pipeline->chunks);
+    queue_init(&pipeline->batches);
+    pipeline->total = UINT64_MAX;
+    pipeline->fd = open(path, O_RDONLY);
+    if(pipeline->fd < 0) {
+        free(pipeline);
+        return false;
+    }
+    posix_fadvise(pipeline->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    if(pthread_create(&reader, NULL, reader_main, pipeline) != 0) {
+        close(pipeline->fd);
+        free(pipeline);
+        return false;
+    }
+    for(; started < workers; started++)
+        if(pthread_create(&parsers[started], NULL, parser_main, pipeline) != 0)
+            break;
+    if(!started) {
+        /* nobody would drain the queues, let the reader finish on its own */
+        __atomic_store_n(&pipeline->stop, 1, __ATOMIC_RELEASE);
+        ok = false;
+    }
+
+    /* builder: link batches in the original order */
+    for(uint64_t next = 0; started;) {
+        Pipeline_Chunk_t* chunk;
+
+        if(__atomic_load_n(&pipeline->readerDone, __ATOMIC_ACQUIRE) &&
+           next >= __atomic_load_n(&pipeline->total, __ATOMIC_ACQUIRE))
+            break;
+
+        chunk = queue_try_pop(&pipeline->batches);
+        if(chunk) {
+            window[chunk->seq & (PIPELINE_WINDOW - 1)] = chunk;
+        } else if(!window[next & (PIPELINE_WINDOW - 1)]) {
+            sched_yield();
+            continue;
+        }
+
+        while((chunk = window[next & (PIPELINE_WINDOW - 1)]) &&
+              chunk->seq == next) {
+            window[next & (PIPELINE_WINDOW - 1)] = NULL;
+            for(size_t i = 0; ok && i < chunk->parsed; i++) {
+                List_Node_t* node = List_Node_Alloc(list);
+                if(!node) {
+                    ok = false;
+                    break;
+                }
+                node->data = chunk->batch[i];
+                List_Link_After(list, last, node);
+                last = node;
+                loaded++;
+            }
+            if(!chunk->ok)
+                ok = false;
+            if(!ok)
+                __atomic_store_n(&pipeline->stop, 1, __ATOMIC_RELEASE);
+            chunk_free(chunk);
+            next++;
+            __atomic_store_n(&pipeline->consumed, next, __ATOMIC_RELEASE);
+        }
+    }
+
+    pthread_join(reader, NULL);
+    for(int i = 0; i < started; i++)
+        pthread_join(parsers[i], NULL);
+    if(pipeline->readError)
+        ok = false;
+
+    /* anything left over after a failure */
+    for(Pipeline_Chunk_t* chunk; (chunk = queue_try_pop(&pipeline->chunks));)
+        chunk_free(chunk);
+    for(Pipeline_Chunk_t* chunk; (chunk = queue_try_pop(&pipeline->batches));)
+        chunk_free(chunk);
+    for(unsigned i = 0; i < PIPELINE_WINDOW; i++)
+        if(window[i])
+            chunk_free(window[i]);
+
+    close(pipeline->fd);
+    free(pipeline);
+    if(count)
+        *count = loaded;
+    return ok;
+}
+
+#else /* !__linux__ */
+
+bool List_Load_Text_Parallel(List_t* const list, const char* path, int workers,
+                             size_t* count) {
+    (void)workers;
+    return List_Load_Text(list, path, count);
+}
+
+#endif /* __linux__ */
@@ -7,15 +7,33 @@
  * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
  */
 
+#if !defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 200809L
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 /* Private includes -------------------------------------------------------- */
 #include "list.h"
 #include "data.h"
+#include "trace.h"
+#include "server.h"
+#include "query.h"
 #include "ioutils.h"
 #include <stdio.h>
 #include <ctype.h>
+#include <signal.h>
 #include <stdlib.h>
 #include <string.h>
 
+/** Longest query accepted by the Q command */
+#define QUERY_MAX 1024
+
+/** Size of the stdout buffer in batch mode */
+#define BATCH_OUTPUT_BUFFER ( 64 * 1024 )
+
+/** Set by SIGINT/SIGTERM to stop the server mode */
+static volatile sig_atomic_t stopServer = 0;
+
 void menu()
 {
     printf( "Type char 0-A for one of the following options:\n" );
@@ -63,7 +81,256 @@ void Vypis_Seznam( List_t list )
     printf( "\n" );
 }
 
-int main()
+void usage( const char * program )
+{
+    printf( "Usage: %s                interactive menu\n", program );
+    printf( "       %s -b [FILE]      batch mode, commands from FILE or stdin\n",
+            program );
+    printf( "       %s -r TRACE ...   record executed operations into TRACE\n",
+            program );
+    printf( "       %s -s SOCKET      serve the list over a UNIX domain socket\n",
+            program );
+    printf( "\nBatch mode reads the same commands as the menu, without echo and\n"
+            "without printing the list after every command. Output is produced\n"
+            "only by 4 (Copy_First), 8 (Copy), A (Is_Active), Q (query, the\n"
+            "next line is the query) and P (print the whole list).\n" );
+    printf( "\nWith -r every executed list operation (0-9, A) is appended to a\n"
+            "binary trace, which can be replayed by the replay tool.\n" );
+    printf( "\nServer mode shares one list between all clients of SOCKET until\n"
+            "SIGINT or SIGTERM, the protocol is described in server.h.\n" );
+}
+
+void Zaznamenej( Trace_Writer_t * trace, char c, const Data_t * data )
+{
+    int op = Trace_Op_From_Char( c );
+
+    if( trace != NULL && op >= 0 ) {
+        Trace_Record( trace, ( Trace_Op_t )op, data );
+    }
+}
+
+void Smaz_Seznam( List_t * list )
+{
+    List_First( list );
+
+    while( List_Is_Active( *list ) ) {
+        List_Succ( list );
+        List_Delete_First( list );
+    }
+}
+
+bool Vypis_Zaznam( const Data_t * data, void * context )
+{
+    char line[DATA_FORMAT_MAX];
+
+    ( void )context;
+    fwrite( line, 1, Data_Format( data, line ), stdout );
+    return true;
+}
+
+void Spust_Dotaz( List_t seznam, char * text )
+{
+    char error[128];
+    Query_t * query;
+    size_t matches;
+
+    text[strcspn( text, "\n\r" )] = 0;
+    query = Query_Compile( text, error, sizeof( error ) );
+
+    if( query == NULL ) {
+        printf( "Query error: %s\n", error[0] ? error : "out of memory" );
+        return;
+    }
+
+    matches = List_Query( seznam, query, Vypis_Zaznam, NULL );
+    printf( "Matches=%lu\n", ( unsigned long )matches );
+    Query_Free( query );
+}
+
+void on_stop_signal( int signum )
+{
+    ( void )signum;
+    stopServer = 1;
+}
+
+int run_server( const char * path )
+{
+#ifdef __linux__
+    struct sigaction action;
+#endif
+    Server_t * server;
+    List_t seznam;
+    bool ok;
+
+    List_Init( &seznam );
+    server = Server_Open( &seznam, path );
+
+    if( server == NULL ) {
+        fprintf( stderr, "Can't listen on %s\n", path );
+        return 1;
+    }
+
+#ifdef __linux__
+    memset( &action, 0, sizeof( action ) );
+    action.sa_handler = on_stop_signal;
+    sigemptyset( &action.sa_mask );
+    sigaction( SIGINT, &action, NULL );
+    sigaction( SIGTERM, &action, NULL );
+#else
+    signal( SIGINT, on_stop_signal );
+    signal( SIGTERM, on_stop_signal );
+#endif
+
+    ok = Server_Run( server, &stopServer );
+    Server_Close( server );
+    Smaz_Seznam( &seznam );
+
+    if( !ok ) {
+        fprintf( stderr, "Server failed\n" );
+        return 1;
+    }
+
+    return 0;
+}
+
+int run_batch( const char * path, Trace_Writer_t * trace )
+{
+    static char output[BATCH_OUTPUT_BUFFER];
+    io_reader_t reader;
+    FILE * input = stdin;
+    List_t seznam;
+    Data_t data;
+    char text[QUERY_MAX];
+    long command = 0;
+    char c;
+
+    if( path != NULL && strcmp( path, "-" ) != 0 ) {
+        input = fopen( path, "r" );
+
+        if( input == NULL ) {
+            fprintf( stderr, "Can't open %s\n", path );
+            return 1;
+        }
+    }
+
+    if( !io_reader_open_file( &reader, input, 0 ) ) {
+        fprintf( stderr, "Out of memory\n" );
+        return 1;
+    }
+
+    setvbuf( stdout, output, _IOFBF, sizeof( output ) );
+    List_Init( &seznam );
+
+    while( io_reader_get_char( &reader, &c ) ) {
+        bool ok = true;
+
+        command++;
+
+        switch( toupper( c ) ) {
+            case '0':
+                Smaz_Seznam( &seznam );
+                List_Init( &seznam );
+                break;
+
+            case '1':
+                ok = Data_Read( &reader, &data );
+
+                if( ok ) {
+                    List_Actualize( &seznam, data );
+                }
+
+                break;
+
+            case '2':
+                ok = Data_Read( &reader, &data );
+
+                if( ok ) {
+                    List_Insert_First( &seznam, data );
+                }
+
+                break;
+
+            case '3':
+                List_First( &seznam );
+                break;
+
+            case '4':
+                if( List_Copy_First( seznam, &data ) ) {
+                    Data_Print( &data );
+                }
+
+                break;
+
+            case '5':
+                List_Delete_First( &seznam );
+                break;
+
+            case '6':
+                List_Post_Delete( &seznam );
+                break;
+
+            case '7':
+                ok = Data_Read( &reader, &data );
+
+                if( ok ) {
+                    List_Post_Insert( &seznam, data );
+                }
+
+                break;
+
+            case '8':
+                if( List_Copy( seznam, &data ) ) {
+                    Data_Print( &data );
+                }
+
+                break;
+
+            case '9':
+                List_Succ( &seznam );
+                break;
+
+            case 'A':
+                printf( "Is_Active=%s\n", List_Is_Active( seznam ) ? "true" : "false" );
+                break;
+
+            case 'Q':
+                if( io_reader_get_string( &reader, text, sizeof( text ) ) ) {
+                    Spust_Dotaz( seznam, text );
+                }
+
+                break;
+
+            case 'P':
+                fflush( stdout );
+                List_Dump( seznam, fileno( stdout ) );
+                break;
+
+            case 'M':
+            case '\n':
+                break;
+
+            default:
+                fprintf( stderr, "Command %ld: unknown command '%c'\n", command, c );
+                break;
+        }
+
+        if( ok ) {
+            Zaznamenej( trace, toupper( c ), &data );
+        }
+    }
+
+    fflush( stdout );
+    Smaz_Seznam( &seznam );
+    io_reader_close( &reader );
+
+    if( input != stdin ) {
+        fclose( input );
+    }
+
+    return 0;
+}
+
+int run_interactive( Trace_Writer_t * trace )
 {
     //Eclipse console bug workaround:
     setvbuf( stdout, NULL, _IONBF, 0 );
@@ -71,6 +338,7 @@ int main()
     printf( "List test program\n" );
     List_t seznam;
     Data_t data;
+    char text[QUERY_MAX];
     List_Init( &seznam ); /*kdyby uzivatel zapomel na zacatku iniciovat seznam... */
     menu();
     bool running = true;
@@ -170,6 +438,17 @@ int main()
 
                 break;
 
+            case 'Q':
+                printf( "Query - Print items matching a query, e.g. name ^= J and age > 30\n" );
+                printf( "Enter query: " );
+                running = io_utils_get_string( text, sizeof( text ) );
+
+                if( running ) {
+                    Spust_Dotaz( seznam, text );
+                }
+
+                break;
+
             case 'M':
             case 'm':
 
@@ -182,6 +461,10 @@ int main()
                 break;
         }
 
+        if( running ) {
+            Zaznamenej( trace, toupper( c ), &data );
+        }
+
         Vypis_Seznam( seznam );
         printf(
             "Type char 0-A, EOF(tj. CTRL+Z nebo CTRL+D)=Konec, M=Menu:\n" );
@@ -189,12 +472,62 @@ int main()
             "************************************************************\n" );
     }
 
-    List_First( &seznam );
+    Smaz_Seznam( &seznam );
+    return 0;
+}
 
-    while( List_Is_Active( seznam ) ) {
-        List_Succ( &seznam );
-        List_Delete_First( &seznam );
+int main( int argc, char ** argv )
+{
+    Trace_Writer_t writer;
+    Trace_Writer_t * trace = NULL;
+    const char * tracePath = NULL;
+    const char * batchPath = NULL;
+    const char * socketPath = NULL;
+    bool batch = false;
+    int result = 0;
+
+    for( int i = 1; i < argc; i++ ) {
+        if( strcmp( argv[i], "-b" ) == 0 || strcmp( argv[i], "--batch" ) == 0 ) {
+            batch = true;
+
+            if( i + 1 < argc && ( argv[i + 1][0] != '-' || argv[i + 1][1] == '\0' ) ) {
+                batchPath = argv[++i];
+            }
+        } else if( ( strcmp( argv[i], "-r" ) == 0 || strcmp( argv[i], "--record" ) == 0 )
+                   && i + 1 < argc ) {
+            tracePath = argv[++i];
+        } else if( ( strcmp( argv[i], "-s" ) == 0 || strcmp( argv[i], "--serve" ) == 0 )
+                   && i + 1 < argc ) {
+            socketPath = argv[++i];
+        } else {
+            usage( argv[0] );
+            return strcmp( argv[i], "-h" ) == 0 ? 0 : 1;
+        }
     }
 
-    return 0;
+    if( socketPath != NULL ) {
+        return run_server( socketPath );
+    }
+
+    if( tracePath != NULL ) {
+        if( !Trace_Open( &writer, tracePath ) ) {
+            fprintf( stderr, "Can't create %s\n", tracePath );
+            return 1;
+        }
+
+        trace = &writer;
+    }
+
+    if( batch ) {
+        result = run_batch( batchPath, trace );
+    } else {
+        result = run_interactive( trace );
+    }
+
+    if( trace != NULL && !Trace_Close( trace ) ) {
+        fprintf( stderr, "Can't write %s\n", tracePath );
+        result = 1;
+    }
+
+    return result;
 }
@@ -0,0 +1,439 @@
+/**
+ * @file       order.c
+ * @date       10/2026
+ * @brief      Order-statistic index of a linear list: positional access in
+ * O(log n)
+ * ****************************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * The index is an implicit treap: a randomized binary search tree ordered
+ * by list position, where every tree node keeps the size of its subtree.
+ * The k-th item is found by descending along the sizes, the position of a
+ * tree node by climbing its parent links. Tree nodes live in one array and
+ * refer to each other by 32-bit slot numbers (slot 0 is the empty tree),
+ * so the list nodes are not changed at all. A list node is mapped to its
+ * slot by an open addressing hash table of slot numbers, keyed by the node
+ * address stored in the slot.
+ */
+
+/* Private includes -------------------------------------------------------- */
+#include "order.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "list_ext.h"
+
+/* Private types and constants --------------------------------------------- */
+#define ORDER_NIL 0u
+/** Smallest number of slots and hash buckets */
+#define ORDER_MIN_CAPACITY 64u
+/** Most items an index can hold, keeps slot and bucket counts in 32 bits */
+#define ORDER_MAX_ITEMS (UINT32_MAX / 4)
+
+typedef struct {
+    List_Node_t* node;       /**< indexed item, NULL for a free slot */
+    uint32_t left;           /**< left subtree (earlier items) */
+    uint32_t right;          /**< right subtree (later items) */
+    uint32_t parent;         /**< parent in the tree, ORDER_NIL for the root */
+    uint32_t size;           /**< number of items in the subtree */
+    uint32_t priority;       /**< heap priority, a parent's is not smaller */
+} Order_Slot_t;
+
+struct List_Order_s {
+    Order_Slot_t* slots; /**< slot 0 is the empty tree */
+    uint32_t capacity;   /**< allocated slots */
+    uint32_t used;       /**< slots ever handed out, including slot 0 */
+    uint32_t freeSlot;   /**< first free slot, chained through right */
+    uint32_t root;       /**< root of the tree */
+    uint32_t random;     /**< xorshift state for priorities */
+    uint32_t* buckets;   /**< slot numbers, ORDER_NIL is an empty bucket */
+    uint32_t bucketBits; /**< log2 of the number of buckets */
+};
+
+/* Private functions ------------------------------------------------------- */
+
+static uint32_t next_priority(List_Order_t* order) {
+    uint32_t x = order->random;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return order->random = x;
+}
+
+static uint32_t size_of(const List_Order_t* order, uint32_t slot) {
+    return order->slots[slot].size;
+}
+
+static void update(List_Order_t* order, uint32_t slot) {
+    Order_Slot_t* s = &order->slots[slot];
+    s->size = 1 + size_of(order, s->left) + size_of(order, s->right);
+}
+
+static void set_parent(List_Order_t* order, uint32_t slot, uint32_t parent) {
+    if(slot != ORDER_NIL)
+        order->slots[slot].parent = parent;
+}
+
+/** Splits a tree into its first count items and the rest */
+static void split(List_Order_t* order, uint32_t tree, uint32_t count, uint32_t* left,
+                  uint32_t* right) {
+    Order_Slot_t* t;
+
+    if(tree == ORDER_NIL) {
+        *left = *right = ORDER_NIL;
+        return;
+    }
+    t = &order->slots[tree];
+    if(size_of(order, t->left) < count) {
+        split(order, t->right, count - size_of(order, t->left) - 1, &t->right, right);
+        set_parent(order, t->right, tree);
+        *left = tree;
+    } else {
+        split(order, t->left, count, left, &t->left);
+        set_parent(order, t->left, tree);
+        *right = tree;
+    }
+    update(order, tree);
+}
+
+/** Joins two trees, all items of the left one come first */
+static uint32_t merge(List_Order_t* order, uint32_t left, uint32_t right) {
+    if(left == ORDER_NIL)
+        return right;
+    if(right == ORDER_NIL)
+        return left;
+
+    if(order->slots[left].priority >= order->slots[right].priority) {
+        Order_Slot_t* l = &order->slots[left];
+        l->right = merge(order, l->right, right);
+        set_parent(order, l->right, left);
+        update(order, left);
+        return left;
+    } else {
+        Order_Slot_t* r = &order->slots[right];
+        r->left = merge(order, left, r->left);
+        set_parent(order, r->left, right);
+        update(order, right);
+        return right;
+    }
+}
+
+static uint32_t rank_of(const List_Order_t* order, uint32_t slot) {
+    uint32_t rank = size_of(order, order->slots[slot].left);
+
+    for(uint32_t parent = order->slots[slot].parent; parent != ORDER_NIL;
+        slot = parent, parent = order->slots[slot].parent) {
+        if(order->slots[parent].right == slot)
+            rank += size_of(order, order->slots[parent].left) + 1;
+    }
+    return rank;
+}
+
+static uint32_t bucket_of(const List_Order_t* order, const List_Node_t* node) {
+    uint64_t h = (uint64_t)(uintptr_t)node * UINT64_C(0x9E3779B97F4A7C15);
+    return (uint32_t)(h >> (64 - order->bucketBits));
+}
+
+static uint32_t find_slot(const List_Order_t* order, const List_Node_t* node) {
+    uint32_t mask = (1u << order->bucketBits) - 1;
+
+    for(uint32_t b = bucket_of(order, node); order->buckets[b] != ORDER_NIL;
+        b = (b + 1) & mask) {
+        if(order->slots[order->buckets[b]].node == node)
+            return order->buckets[b];
+    }
+    return ORDER_NIL;
+}
+
+static void hash_put(List_Order_t* order, uint32_t slot) {
+    uint32_t mask = (1u << order->bucketBits) - 1;
+    uint32_t b = bucket_of(order, order->slots[slot].node);
+
+    while(order->buckets[b] != ORDER_NIL)
+        b = (b + 1) & mask;
+    order->buckets[b] = slot;
+}
+
+/** Removes a slot from the hash table, moving back the entries after it */
+static void hash_remove(List_Order_t* order, uint32_t slot) {
+    uint32_t mask = (1u << order->bucketBits) - 1;
+    uint32_t hole = bucket_of(order, order->slots[slot].node);
+
+    while(order->buckets[hole] != slot)
+        hole = (hole + 1) & mask;
+    order->buckets[hole] = ORDER_NIL;
+
+    for(uint32_t b = (hole + 1) & mask; order->buckets[b] != ORDER_NIL; b = (b + 1) & mask) {
+        uint32_t home = bucket_of(order, order->slots[order->buckets[b]].node);
+
+        /* the entry may move to the hole unless its home lies in (hole, b] */
+        if(((b - home) & mask) >= ((b - hole) & mask)) {
+            order->buckets[hole] = order->buckets[b];
+            order->buckets[b] = ORDER_NIL;
+            hole = b;
+        }
+    }
+}
+
+/** Makes room for count items: slots and a hash table at most half full */
+static bool reserve(List_Order_t* order, uint32_t count) {
+    uint32_t bits = order->bucketBits;
+
+    if(count >= ORDER_MAX_ITEMS)
+        return false;
+    if(count + 1 > order->capacity) {
+        uint32_t capacity = order->capacity ? order->capacity : ORDER_MIN_CAPACITY;
+        Order_Slot_t* slots;
+
+        while(capacity < count + 1)
+            capacity *= 2;
+        slots = realloc(order->slots, (size_t)capacity * sizeof(Order_Slot_t));
+        if(!slots)
+            return false;
+        order->slots = slots;
+        order->capacity = capacity;
+    }
+
+    while((1u << bits) < 2 * count || (1u << bits) < ORDER_MIN_CAPACITY)
+        bits++;
+    if(bits != order->bucketBits || !order->buckets) {
+        uint32_t* buckets = calloc((size_t)1 << bits, sizeof(uint32_t));
+
+        if(!buckets)
+            return false;
+        free(order->buckets);
+        order->buckets = buckets;
+        order->bucketBits = bits;
+        for(uint32_t slot = 1; slot < order->used; slot++) {
+            if(order->slots[slot].node)
+                hash_put(order, slot);
+        }
+    }
+    return true;
+}
+
+static uint32_t new_slot(List_Order_t* order, List_Node_t* node) {
+    uint32_t slot;
+    Order_Slot_t* s;
+
+    if(order->freeSlot != ORDER_NIL) {
+        slot = order->freeSlot;
+        order->freeSlot = order->slots[slot].right;
+    } else {
+        slot = order->used++;
+    }
+    s = &order->slots[slot];
+    s->node = node;
+    s->left = s->right = s->parent = ORDER_NIL;
+    s->size = 1;
+    s->priority = next_priority(order);
+    return slot;
+}
+
+/** Returns the slot of the item at the position, the tree must hold it */
+static uint32_t select_slot(const List_Order_t* order, size_t position) {
+    uint32_t slot = order->root;
+
+    for(;;) {
+        uint32_t left = size_of(order, order->slots[slot].left);
+
+        if(position < left) {
+            slot = order->slots[slot].left;
+        } else if(position == left) {
+            return slot;
+        } else {
+            position -= left + 1;
+            slot = order->slots[slot].right;
+        }
+    }
+}
+
+static void order_free(List_Order_t* order) {
+    if(!order)
+        return;
+    free(order->slots);
+    free(order->buckets);
+    free(order);
+}
+
+/* Functions definitions --------------------------------------------------- */
+
+bool List_Order_Attach(List_t* const list) {
+    List_Ext_t* ext;
+    List_Order_t* order;
+    uint32_t* spine;
+    uint32_t depth = 0;
+    size_t count = 0;
+
+    if(!list)
+        return false;
+    if(List_Order_Attached(*list))
+        return true;
+    for(List_Node_t* node = list->first; node; node = node->next)
+        count++;
+    if(count >= ORDER_MAX_ITEMS)
+        return false;
+
+    order = calloc(1, sizeof(*order));
+    spine = malloc((count + 1) * sizeof(uint32_t));
+    if(!order || !spine || !reserve(order, (uint32_t)count)) {
+        order_free(order);
+        free(spine);
+        return false;
+    }
+    order->random = 0x2545F491u;
+    order->used = 1;
+    order->slots[ORDER_NIL].size = 0;
+
+    /* Cartesian tree build: the right spine is kept on a stack, every slot
+     * popped from it is complete, so its size is final */
+    for(List_Node_t* node = list->first; node; node = node->next) {
+        uint32_t slot = new_slot(order, node);
+        uint32_t last = ORDER_NIL;
+
+        hash_put(order, slot);
+        while(depth && order->slots[spine[depth - 1]].priority < order->slots[slot].priority) {
+            last = spine[--depth];
+            update(order, last);
+        }
+        order->slots[slot].left = last;
+        set_parent(order, last, slot);
+        if(depth) {
+            order->slots[spine[depth - 1]].right = slot;
+            order->slots[slot].parent = spine[depth - 1];
+        }
+        spine[depth++] = slot;
+    }
+    while(depth)
+        update(order, spine[--depth]);
+    order->root = count ? spine[0] : ORDER_NIL;
+
+    free(spine);
+    ext = List_Ext_Get(list);
+    if(!ext) {
+        order_free(order);
+        return false;
+    }
+    ext->order = order;
+    return true;
+}
+
+void List_Order_Detach(List_t* const list) {
+    if(!list || !List_Order_Attached(*list))
+        return;
+    order_free(list->ext->order);
+    list->ext->order = NULL;
+    List_Ext_Release(list);
+}
+
+bool List_Order_Link(List_Order_t* order, const List_Node_t* node,
+                     List_Node_t* newNode) {
+    uint32_t position = 0;
+    uint32_t count = size_of(order, order->root);
+    uint32_t slot, left, right;
+
+    if(node) {
+        uint32_t after = find_slot(order, node);
+
+        if(after == ORDER_NIL)
+            return false;
+        position = rank_of(order, after) + 1;
+    }
+    if(!reserve(order, count + 1))
+        return false;
+
+    slot = new_slot(order, newNode);
+    hash_put(order, slot);
+    split(order, order->root, position, &left, &right);
+    order->root = merge(order, merge(order, left, slot), right);
+    order->slots[order->root].parent = ORDER_NIL;
+    return true;
+}
+
+void List_Order_Unlink(List_Order_t* order, const List_Node_t* node) {
+    uint32_t slot = find_slot(order, node);
+    uint32_t parent, child;
+    Order_Slot_t* s;
+
+    if(slot == ORDER_NIL)
+        return;
+    s = &order->slots[slot];
+    parent = s->parent;
+    child = merge(order, s->left, s->right);
+    set_parent(order, child, parent);
+    if(parent == ORDER_NIL) {
+        order->root = child;
+    } else {
+        if(order->slots[parent].left == slot)
+            order->slots[parent].left = child;
+        else
+            order->slots[parent].right = child;
+        for(uint32_t p = parent; p != ORDER_NIL; p = order->slots[p].parent)
+            order->slots[p].size--;
+    }
+
+    hash_remove(order, slot);
+    s->node = NULL;
+    s->right = order->freeSlot;
+    order->freeSlot = slot;
+}
+
+bool List_Seek(List_t* const list, size_t position) {
+    List_Ext_t* ext;
+    List_Node_t* node;
+
+    if(!list)
+        return false;
+    ext = list->ext;
+    if(ext && ext->order) {
+        if(position >= size_of(ext->order, ext->order->root))
+            return false;
+        list->active = ext->order->slots[select_slot(ext->order, position)].node;
+        return true;
+    }
+
+    for(node = list->first; node && position; node = node->next)
+        position--;
+    if(!node)
+        return false;
+    list->active = node;
+    return true;
+}
+
+bool List_Position(List_t list, size_t* position) {
+    size_t rank = 0;
+
+    if(!position || !list.active)
+        return false;
+    if(List_Order_Attached(list)) {
+        uint32_t slot = find_slot(list.ext->order, list.active);
+
+        if(slot == ORDER_NIL)
+            return false;
+        *position = rank_of(list.ext->order, slot);
+        return true;
+    }
+
+    for(List_Node_t* node = list.first; node; node = node->next, rank++) {
+        if(node == list.active) {
+            *position = rank;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t List_Length(List_t list) {
+    size_t length = 0;
+
+    if(List_Order_Attached(list))
+        return size_of(list.ext->order, list.ext->order->root);
+    for(List_Node_t* node = list.first; node; node = node->next)
+        length++;
+    return length;
+}
+
+bool List_Order_Attached(List_t list) {
+    return list.ext && list.ext->order;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file       order.h
+ * @date       10/2026
+ * @brief      Order-statistic index of a linear list: positional access in
+ * O(log n)
+ * **********************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * The index is attached to a list at run time. Once attached, the list
+ * operations keep it consistent on every insert and delete, and List_Seek,
+ * List_Position and List_Length answer in O(log n) (List_Length in O(1))
+ * instead of walking the list. Without an index the same calls walk the
+ * list from the first item, so callers need not care whether one is
+ * attached.
+ */
+
+#ifndef ORDER_H
+#define ORDER_H
+
+/* Public includes --------------------------------------------------------- */
+#include <stdbool.h>
+#include <stddef.h>
+#include "list.h"
+
+/* Public order-statistic API ---------------------------------------------- */
+/**
+ * @brief Builds the order-statistic index of the current items in O(n) and
+ * attaches it to the list. The index costs about 40 bytes per item. If
+ * it can not grow during a later insert, it is detached and positional
+ * access falls back to walking the list. List_Free releases the index.
+ * @param list[in] - list, which should be indexed
+ * @return Returns false if the index could not be allocated, true if it is
+ * attached (or was already)
+ */
+bool List_Order_Attach(List_t* const list);
+
+/**
+ * @brief Releases the index of the list, if any
+ * @param list[in] - list, whose index should be released
+ */
+void List_Order_Detach(List_t* const list);
+
+/**
+ * @brief Tells whether an index is attached to the list
+ */
+bool List_Order_Attached(List_t list);
+
+/**
+ * @brief Sets the active item to the item at the given position
+ * @param list[in] - list, with which the operation should be done
+ * @param position[in] - zero based position of the item
+ * @return Returns false and keeps the active item if there is no such item
+ */
+bool List_Seek(List_t* const list, size_t position);
+
+/**
+ * @brief Returns the position of the active item
+ * @param list[in] - list, with which the operation should be done
+ * @param position[out] - zero based position of the active item
+ * @return Returns false if there is no active item
+ */
+bool List_Position(List_t list, size_t* position);
+
+/**
+ * @brief Returns the number of items in the list
+ */
+size_t List_Length(List_t list);
+
+/* Index maintenance, called by list.c ------------------------------------- */
+/**
+ * @brief Records that newNode was linked after node (at the start of the
+ * list when node is NULL)
+ * @return Returns false if the index could not grow and is no longer valid
+ */
+bool List_Order_Link(List_Order_t* order, const List_Node_t* node,
+                     List_Node_t* newNode);
+
+/**
+ * @brief Records that node is being unlinked from the list
+ */
+void List_Order_Unlink(List_Order_t* order, const List_Node_t* node);
+
+#endif /* ORDER_H */
@@ -0,0 +1,375 @@
+/**
+ * @file       plist.c
+ * @date       10/2026
+ * @brief      Persistent linear list living in a memory mapped file
+ * ****************************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * Every item is addressed by its offset in the file, so the mapping may move
+ * when the file grows and nothing has to be fixed up. The file grows by
+ * doubling; deleted items are chained into a free list in the file and
+ * reused before the file grows.
+ */
+
+#define _GNU_SOURCE
+
+#if !defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 200809L
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+/* Private includes -------------------------------------------------------- */
+#include "plist.h"
+
+#include <string.h>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* Private types and constants --------------------------------------------- */
+#define PLIST_MAGIC "LISTPMAP"
+#define PLIST_BOM 0x01020304u
+#define PLIST_MIN_SIZE ((size_t)1 << 20)
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t bom;
+    uint64_t nodeSize;
+    uint64_t first;
+    uint64_t active;
+    uint64_t free;
+    uint64_t count;
+    uint64_t used;
+} PList_Header_t;
+
+typedef struct {
+    Data_t data;
+    uint64_t next;
+} PList_Node_t;
+
+/* Private functions ------------------------------------------------------- */
+
+static PList_Header_t* header(const PList_t* const list) {
+    return (PList_Header_t*)list->map;
+}
+
+static PList_Node_t* node_at(const PList_t* const list, uint64_t offset) {
+    return (PList_Node_t*)(list->map + offset);
+}
+
+#ifdef __linux__
+
+/** Checks that an offset is none or the start of an item in the used part */
+static bool valid_offset(const PList_Header_t* h, uint64_t offset) {
+    return offset == 0 || (offset >= sizeof(PList_Header_t) && offset < h->used &&
+                           (offset - sizeof(PList_Header_t)) % sizeof(PList_Node_t) == 0);
+}
+
+static bool resize(PList_t* const list, size_t size) {
+    unsigned char* map;
+
+    if(ftruncate(list->fd, (off_t)size) != 0)
+        return false;
+#ifdef MREMAP_MAYMOVE
+    map = mremap(list->map, list->size, size, MREMAP_MAYMOVE);
+#else
+    map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, list->fd, 0);
+    if(map != MAP_FAILED)
+        munmap(list->map, list->size);
+#endif
+    if(map == MAP_FAILED)
+        return false;
+    list->map = map;
+    list->size = size;
+    return true;
+}
+
+#else /* !__linux__ */
+
+static bool resize(PList_t* const list, size_t size) {
+    (void)list;
+    (void)size;
+    return false;
+}
+
+#endif /* __linux__ */
+
+/** Returns the offset of a new item, 0 if the file could not grow */
+static uint64_t node_alloc(PList_t* const list) {
+    PList_Header_t* h = header(list);
+    uint64_t offset = h->free;
+
+    if(offset) {
+        h->free = node_at(list, offset)->next;
+        return offset;
+    }
+    if(h->used + sizeof(PList_Node_t) > list->size) {
+        size_t size = list->size * 2;
+
+        while(size < h->used + sizeof(PList_Node_t))
+            size *= 2;
+        if(!resize(list, size))
+            return 0;
+        h = header(list);
+    }
+    offset = h->used;
+    h->used += sizeof(PList_Node_t);
+    return offset;
+}
+
+static void node_free(PList_t* const list, uint64_t offset) {
+    PList_Header_t* h = header(list);
+
+    node_at(list, offset)->next = h->free;
+    h->free = offset;
+    h->count--;
+}
+
+/** Links a new item after the item at offset, at the start if it is 0 */
+static uint64_t insert_after(PList_t* const list, uint64_t offset, const Data_t* data) {
+    uint64_t fresh = node_alloc(list);
+    PList_Header_t* h = header(list);
+    PList_Node_t* node;
+
+    if(!fresh)
+        return 0;
+    node = node_at(list, fresh);
+    node->data = *data;
+    if(offset) {
+        node->next = node_at(list, offset)->next;
+        node_at(list, offset)->next = fresh;
+    } else {
+        node->next = h->first;
+        h->first = fresh;
+    }
+    h->count++;
+    return fresh;
+}
+
+/* Functions definitions --------------------------------------------------- */
+
+#ifdef __linux__
+
+bool PList_Open(PList_t* const list, const char* path) {
+    PList_Header_t* h;
+    struct stat st;
+
+    if(!list || !path)
+        return false;
+    list->map = NULL;
+    list->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if(list->fd < 0)
+        return false;
+    if(flock(list->fd, LOCK_EX | LOCK_NB) != 0 || fstat(list->fd, &st) != 0)
+        goto fail;
+
+    if(st.st_size == 0) {
+        PList_Header_t empty;
+
+        memset(&empty, 0, sizeof(empty));
+        memcpy(empty.magic, PLIST_MAGIC, sizeof(empty.magic));
+        empty.version = PLIST_VERSION;
+        empty.bom = PLIST_BOM;
+        empty.nodeSize = sizeof(PList_Node_t);
+        empty.used = sizeof(PList_Header_t);
+        if(ftruncate(list->fd, (off_t)PLIST_MIN_SIZE) != 0 ||
+           pwrite(list->fd, &empty, sizeof(empty), 0) != (ssize_t)sizeof(empty))
+            goto fail;
+        st.st_size = (off_t)PLIST_MIN_SIZE;
+    }
+    if((size_t)st.st_size < sizeof(PList_Header_t))
+        goto fail;
+
+    list->size = (size_t)st.st_size;
+    list->map = mmap(NULL, list->size, PROT_READ | PROT_WRITE, MAP_SHARED, list->fd, 0);
+    if(list->map == MAP_FAILED) {
+        list->map = NULL;
+        goto fail;
+    }
+    h = header(list);
+    if(memcmp(h->magic, PLIST_MAGIC, sizeof(h->magic)) != 0 || h->version != PLIST_VERSION ||
+       h->bom != PLIST_BOM || h->nodeSize != sizeof(PList_Node_t) ||
+       h->used < sizeof(PList_Header_t) || h->used > list->size ||
+       !valid_offset(h, h->first) || !valid_offset(h, h->active) || !valid_offset(h, h->free))
+        goto fail;
+    return true;
+
+fail:
+    if(list->map)
+        munmap(list->map, list->size);
+    close(list->fd);
+    list->map = NULL;
+    list->fd = -1;
+    return false;
+}
+
+bool PList_Close(PList_t* const list) {
+    bool ok = true;
+
+    if(!list || !list->map)
+        return false;
+    ok = munmap(list->map, list->size) == 0;
+    ok = close(list->fd) == 0 && ok;
+    list->map = NULL;
+    list->fd = -1;
+    return ok;
+}
+
+bool PList_Sync(const PList_t* const list) {
+    if(!list || !list->map)
+        return false;
+    return msync(list->map, list->size, MS_SYNC) == 0;
+}
+
+#else /* !__linux__ */
+
+bool PList_Open(PList_t* const list, const char* path) {
+    (void)path;
+    if(list) {
+        list->map = NULL;
+        list->fd = -1;
+    }
+    return false;
+}
+
+bool PList_Close(PList_t* const list) {
+    (void)list;
+    return false;
+}
+
+bool PList_Sync(const PList_t* const list) {
+    (void)list;
+    return false;
+}
+
+#endif /* __linux__ */
+
+size_t PList_Count(const PList_t* const list) {
+    if(!list || !list->map)
+        return 0;
+    return (size_t)header(list)->count;
+}
+
+bool PList_Insert_First(PList_t* const list, Data_t data) {
+    if(!list || !list->map)
+        return false;
+    return insert_after(list, 0, &data) != 0;
+}
+
+void PList_First(PList_t* const list) {
+    if(!list || !list->map)
+        return;
+    header(list)->active = header(list)->first;
+}
+
+bool PList_Copy_First(const PList_t* const list, Data_t* data) {
+    if(!list || !list->map || !data || !header(list)->first)
+        return false;
+    *data = node_at(list, header(list)->first)->data;
+    return true;
+}
+
+void PList_Delete_First(PList_t* const list) {
+    PList_Header_t* h;
+    uint64_t late;
+
+    if(!list || !list->map)
+        return;
+    h = header(list);
+    if(!h->first)
+        return;
+    late = h->first;
+    if(h->active == late)
+        h->active = 0;
+    h->first = node_at(list, late)->next;
+    node_free(list, late);
+}
+
+void PList_Post_Delete(PList_t* const list) {
+    PList_Node_t* active;
+    uint64_t late;
+
+    if(!list || !list->map || !header(list)->active)
+        return;
+    active = node_at(list, header(list)->active);
+    late = active->next;
+    if(!late)
+        return;
+    active->next = node_at(list, late)->next;
+    node_free(list, late);
+}
+
+bool PList_Post_Insert(PList_t* const list, Data_t data) {
+    if(!list || !list->map || !header(list)->active)
+        return false;
+    return insert_after(list, header(list)->active, &data) != 0;
+}
+
+bool PList_Copy(const PList_t* const list, Data_t* data) {
+    if(!list || !list->map || !data || !header(list)->active)
+        return false;
+    *data = node_at(list, header(list)->active)->data;
+    return true;
+}
+
+void PList_Actualize(PList_t* const list, Data_t data) {
+    if(!list || !list->map || !header(list)->active)
+        return;
+    node_at(list, header(list)->active)->data = data;
+}
+
+void PList_Succ(PList_t* const list) {
+    PList_Header_t* h;
+
+    if(!list || !list->map)
+        return;
+    h = header(list);
+    if(h->active)
+        h->active = node_at(list, h->active)->next;
+}
+
+bool PList_Is_Active(const PList_t* const list) {
+    return list && list->map && header(list)->active;
+}
+
+bool PList_Import(PList_t* const list, List_t source) {
+    uint64_t last;
+
+    if(!list || !list->map)
+        return false;
+    last = header(list)->first;
+    if(last) {
+        while(node_at(list, last)->next)
+            last = node_at(list, last)->next;
+    }
+    for(const List_Node_t* node = source.first; node; node = node->next) {
+        last = insert_after(list, last, &node->data);
+        if(!last)
+            return false;
+    }
+    return true;
+}
+
+bool PList_Export(const PList_t* const list, List_t* const target) {
+    List_Node_t* last;
+
+    if(!list || !list->map || !target)
+        return false;
+    last = target->first;
+    if(last) {
+        while(last->next)
+            last = last->next;
+    }
+    for(uint64_t offset = header(list)->first; offset; offset = node_at(list, offset)->next) {
+        last = List_Insert_After(target, last, node_at(list, offset)->data);
+        if(!last)
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file       plist.h
+ * @date       10/2026
+ * @brief      Persistent linear list living in a memory mapped file
+ * **********************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * The items of a PList_t are stored directly in a file mapped into memory
+ * and linked by file offsets instead of pointers, so the list is usable
+ * right after PList_Open whatever its size: nothing is parsed, allocated
+ * or relinked. The operations mirror the List_* API.
+ *
+ * File layout (all numbers in the byte order of the host, offsets are from
+ * the start of the file, 0 means none):
+ *
+ * | offset | size | content                                         |
+ * |--------|------|-------------------------------------------------|
+ * | 0      | 8    | magic "LISTPMAP"                                |
+ * | 8      | 4    | format version (#PLIST_VERSION)                 |
+ * | 12     | 4    | byte order mark 0x01020304                      |
+ * | 16     | 8    | size of one item                                |
+ * | 24     | 8    | offset of the first item                        |
+ * | 32     | 8    | offset of the active item                       |
+ * | 40     | 8    | offset of the first free item                   |
+ * | 48     | 8    | number of items                                 |
+ * | 56     | 8    | end of the used part of the file                |
+ * | 64     | ...  | items: Data_t, then the offset of the next item |
+ *
+ * Changes reach the file through the page cache; PList_Sync makes them
+ * durable. A crash in the middle of an operation may leave the file
+ * inconsistent, there is no journal. The file is locked while open.
+ *
+ * Only available on Linux, elsewhere PList_Open fails.
+ */
+
+#ifndef PLIST_H
+#define PLIST_H
+
+/* Public includes --------------------------------------------------------- */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "list.h"
+
+/** Version of the file format */
+#define PLIST_VERSION 1
+
+/** @struct PList_t
+ * Open persistent list
+ */
+typedef struct {
+  int fd;             /**< descriptor of the file */
+  unsigned char* map; /**< the mapped file */
+  size_t size;        /**< size of the file and the mapping */
+} PList_t;
+
+/* Public PList_t API ------------------------------------------------------ */
+/**
+ * @brief Opens a persistent list, an empty or missing file is initialized as
+ * an empty list. The header is checked, the items are not read.
+ * @param list[out] - the open list
+ * @param path[in] - path of the file
+ * @return Returns false if the file can not be opened, mapped or locked or
+ * is not a persistent list of a supported version
+ */
+bool PList_Open(PList_t* const list, const char* path);
+
+/**
+ * @brief Unmaps and closes the list, without PList_Sync
+ * @return Returns false if closing failed
+ */
+bool PList_Close(PList_t* const list);
+
+/**
+ * @brief Writes all changes to the disk
+ * @return Returns false if writing failed
+ */
+bool PList_Sync(const PList_t* const list);
+
+/**
+ * @brief Returns the number of items in the list
+ */
+size_t PList_Count(const PList_t* const list);
+
+/**
+ * @brief Creates a new item at the start of the list, the active item stays
+ * the same
+ * @return Returns false if the file could not grow
+ */
+bool PList_Insert_First(PList_t* const list, Data_t data);
+
+/**
+ * @brief Sets the first item active
+ */
+void PList_First(PList_t* const list);
+
+/**
+ * @brief Returns data of the first item
+ * @return Returns false if the list is empty
+ */
+bool PList_Copy_First(const PList_t* const list, Data_t* data);
+
+/**
+ * @brief Deletes the first item, if it was active the list has no active item
+ */
+void PList_Delete_First(PList_t* const list);
+
+/**
+ * @brief Deletes the item after the active item
+ */
+void PList_Post_Delete(PList_t* const list);
+
+/**
+ * @brief Inserts a new item after the active item, if there is one
+ * @return Returns false if there is no active item or the file could not
+ * grow
+ */
+bool PList_Post_Insert(PList_t* const list, Data_t data);
+
+/**
+ * @brief Returns data of the active item
+ * @return Returns false if there is no active item
+ */
+bool PList_Copy(const PList_t* const list, Data_t* data);
+
+/**
+ * @brief Updates data of the active item, if there is one
+ */
+void PList_Actualize(PList_t* const list, Data_t data);
+
+/**
+ * @brief Moves the active item to the next one
+ */
+void PList_Succ(PList_t* const list);
+
+/**
+ * @brief Returns true if there is an active item
+ */
+bool PList_Is_Active(const PList_t* const list);
+
+/**
+ * @brief Appends all items of an in-memory list at the end of the
+ * persistent list
+ * @return Returns false if the file could not grow, the items appended so
+ * far stay
+ */
+bool PList_Import(PList_t* const list, List_t source);
+
+/**
+ * @brief Appends all items of the persistent list at the end of an
+ * in-memory list
+ * @return Returns false if an item could not be allocated
+ */
+bool PList_Export(const PList_t* const list, List_t* const target);
+
+#endif /* PLIST_H */
@@ -0,0 +1,445 @@
+/**
+ * @file       query.c
+ * @date       10/2026
+ * @brief      Filter queries over the items of a linear list
+ * ****************************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * A query is compiled by a recursive descent parser straight into a flat
+ * program. Every comparison is one instruction with its field offset and
+ * constant already resolved and a single boolean register; "and" and "or"
+ * become conditional jumps to the end of their chain, so evaluation is
+ * short-circuit and never walks a tree.
+ */
+
+/* Private includes -------------------------------------------------------- */
+#include "query.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bloom.h"
+#include "ioutils.h"
+
+/* Private types and constants --------------------------------------------- */
+typedef enum {
+    OP_NUM_EQ,
+    OP_NUM_NE,
+    OP_NUM_LT,
+    OP_NUM_LE,
+    OP_NUM_GT,
+    OP_NUM_GE,
+    OP_STR_EQ,
+    OP_STR_NE,
+    OP_STR_LT,
+    OP_STR_LE,
+    OP_STR_GT,
+    OP_STR_GE,
+    OP_STR_PREFIX,
+    OP_STR_SUFFIX,
+    OP_STR_CONTAINS,
+    OP_NOT,
+    OP_JUMP_FALSE, /**< jump to target if the register is false */
+    OP_JUMP_TRUE   /**< jump to target if the register is true */
+} Query_Opcode_t;
+
+typedef struct {
+    Query_Opcode_t opcode;
+    size_t offset;  /**< offset of a numeric field in Data_t */
+    size_t target;  /**< index of the jump target */
+    double value;   /**< constant of a numeric comparison */
+    char* text;     /**< constant of a name comparison */
+    size_t len;     /**< length of text */
+} Query_Insn_t;
+
+struct Query_s {
+    Query_Insn_t* code;
+    size_t count;
+    size_t capacity;
+};
+
+typedef struct {
+    const char* text;
+    const char* p;
+    Query_t* query;
+    char* error;
+    size_t errorSize;
+    bool failed;
+} Query_Parser_t;
+
+/** Comparison operators, longer ones first so that "<=" wins over "<" */
+static const struct {
+    const char* symbol;
+    Query_Opcode_t number;
+    Query_Opcode_t string;
+} operators[] = {
+    {"==", OP_NUM_EQ, OP_STR_EQ},       {"!=", OP_NUM_NE, OP_STR_NE},
+    {"<=", OP_NUM_LE, OP_STR_LE},       {">=", OP_NUM_GE, OP_STR_GE},
+    {"^=", OP_NUM_EQ, OP_STR_PREFIX},   {"$=", OP_NUM_EQ, OP_STR_SUFFIX},
+    {"*=", OP_NUM_EQ, OP_STR_CONTAINS}, {"=", OP_NUM_EQ, OP_STR_EQ},
+    {"<", OP_NUM_LT, OP_STR_LT},        {">", OP_NUM_GT, OP_STR_GT},
+};
+
+/* Private functions ------------------------------------------------------- */
+
+static void fail(Query_Parser_t* parser, const char* message) {
+    if(parser->failed)
+        return;
+    parser->failed = true;
+    if(parser->error && parser->errorSize)
+        snprintf(parser->error, parser->errorSize, "column %d: %s",
+                 (int)(parser->p - parser->text) + 1, message);
+}
+
+static void skip_space(Query_Parser_t* parser) {
+    while(isspace((unsigned char)*parser->p))
+        parser->p++;
+}
+
+static bool is_word_char(char c) {
+    return isalnum((unsigned char)c) || c == '_';
+}
+
+/**
+ * @brief Consumes a case insensitive keyword followed by a word boundary
+ */
+static bool accept_word(Query_Parser_t* parser, const char* word) {
+    size_t len = strlen(word);
+
+    skip_space(parser);
+    for(size_t i = 0; i < len; i++) {
+        if(tolower((unsigned char)parser->p[i]) != word[i])
+            return false;
+    }
+    if(is_word_char(parser->p[len]))
+        return false;
+    parser->p += len;
+    return true;
+}
+
+static bool accept_symbol(Query_Parser_t* parser, const char* symbol) {
+    size_t len = strlen(symbol);
+
+    skip_space(parser);
+    if(strncmp(parser->p, symbol, len) != 0)
+        return false;
+    parser->p += len;
+    return true;
+}
+
+static size_t emit(Query_Parser_t* parser, Query_Opcode_t opcode) {
+    Query_t* q = parser->query;
+    Query_Insn_t* insn;
+
+    if(q->count == q->capacity) {
+        size_t capacity = q->capacity ? 2 * q->capacity : 8;
+        Query_Insn_t* code = realloc(q->code, capacity * sizeof(*code));
+        if(!code) {
+            fail(parser, "out of memory");
+            return 0;
+        }
+        q->code = code;
+        q->capacity = capacity;
+    }
+    insn = &q->code[q->count];
+    memset(insn, 0, sizeof(*insn));
+    insn->opcode = opcode;
+    return q->count++;
+}
+
+static void parse_or(Query_Parser_t* parser);
+
+static void parse_comparison(Query_Parser_t* parser) {
+    const char* start;
+    Data_Field_t field;
+    size_t op = sizeof(operators) / sizeof(operators[0]);
+    size_t index;
+    Query_Insn_t* insn;
+
+    skip_space(parser);
+    start = parser->p;
+    while(is_word_char(*parser->p))
+        parser->p++;
+    if(!Data_Field_Parse(start, (size_t)(parser->p - start), &field)) {
+        parser->p = start;
+        fail(parser, "expected name, age, weight or height");
+        return;
+    }
+
+    skip_space(parser);
+    for(size_t i = 0; i < sizeof(operators) / sizeof(operators[0]); i++) {
+        if(accept_symbol(parser, operators[i].symbol)) {
+            op = i;
+            break;
+        }
+    }
+    if(op == sizeof(operators) / sizeof(operators[0])) {
+        fail(parser, "expected comparison operator");
+        return;
+    }
+
+    skip_space(parser);
+    if(field != DATA_FIELD_NAME) {
+        double value;
+        const char* next;
+
+        if(operators[op].string >= OP_STR_PREFIX) {
+            fail(parser, "^=, $= and *= compare only the name");
+            return;
+        }
+        if(!io_utils_parse_double(parser->p, parser->p + strlen(parser->p),
+                                  &value, &next) || next == parser->p) {
+            fail(parser, "expected number");
+            return;
+        }
+        parser->p = next;
+        index = emit(parser, operators[op].number);
+        if(parser->failed)
+            return;
+        insn = &parser->query->code[index];
+        insn->offset = Data_Field_Offset(field);
+        insn->value = value;
+    } else {
+        size_t len;
+
+        if(*parser->p == '"' || *parser->p == '\'') {
+            char quote = *parser->p++;
+            start = parser->p;
+            while(*parser->p && *parser->p != quote)
+                parser->p++;
+            if(!*parser->p) {
+                fail(parser, "unterminated string");
+                return;
+            }
+            len = (size_t)(parser->p++ - start);
+        } else {
+            start = parser->p;
+            while(*parser->p && !isspace((unsigned char)*parser->p) &&
+                  !strchr("()&|", *parser->p))
+                parser->p++;
+            len = (size_t)(parser->p - start);
+            if(!len) {
+                fail(parser, "expected name value");
+                return;
+            }
+        }
+        if(len >= sizeof(((Data_t*)0)->name)) {
+            fail(parser, "name value too long");
+            return;
+        }
+        index = emit(parser, operators[op].string);
+        if(parser->failed)
+            return;
+        insn = &parser->query->code[index];
+        insn->text = malloc(len + 1);
+        if(!insn->text) {
+            fail(parser, "out of memory");
+            return;
+        }
+        memcpy(insn->text, start, len);
+        insn->text[len] = 0;
+        insn->len = len;
+    }
+}
+
+static void parse_not(Query_Parser_t* parser) {
+    skip_space(parser);
+    if(accept_word(parser, "not") ||
+       (parser->p[0] == '!' && parser->p[1] != '=' && accept_symbol(parser, "!"))) {
+        parse_not(parser);
+        emit(parser, OP_NOT);
+    } else if(accept_symbol(parser, "(")) {
+        parse_or(parser);
+        if(!parser->failed && !accept_symbol(parser, ")"))
+            fail(parser, "expected )");
+    } else {
+        parse_comparison(parser);
+    }
+}
+
+/**
+ * @brief Parses a chain of operands joined by one operator. Every operand but
+ * the last one is followed by a jump to the end of the chain, which is taken
+ * as soon as the result of the chain is known.
+ */
+static void parse_chain(Query_Parser_t* parser, void (*operand)(Query_Parser_t*),
+                        const char* word, const char* symbol, Query_Opcode_t jump) {
+    size_t first = parser->query->count;
+
+    operand(parser);
+    while(!parser->failed &&
+          (accept_word(parser, word) || accept_symbol(parser, symbol))) {
+        emit(parser, jump);
+        operand(parser);
+    }
+    for(size_t i = first; i < parser->query->count && !parser->failed; i++) {
+        Query_Insn_t* insn = &parser->query->code[i];
+        if(insn->opcode == jump && insn->target == 0)
+            insn->target = parser->query->count;
+    }
+}
+
+static void parse_and(Query_Parser_t* parser) {
+    parse_chain(parser, parse_not, "and", "&&", OP_JUMP_FALSE);
+}
+
+static void parse_or(Query_Parser_t* parser) {
+    parse_chain(parser, parse_and, "or", "||", OP_JUMP_TRUE);
+}
+
+static inline double field_value(const Data_t* data, size_t offset) {
+    double value;
+    memcpy(&value, (const char*)data + offset, sizeof(value));
+    return value;
+}
+
+static inline bool run(const Query_t* query, const Data_t* data) {
+    const Query_Insn_t* code = query->code;
+    const char* name = data->name;
+    size_t pc = 0;
+    bool r = true;
+
+    while(pc < query->count) {
+        const Query_Insn_t* insn = &code[pc++];
+
+        switch(insn->opcode) {
+        case OP_NUM_EQ:
+            r = field_value(data, insn->offset) == insn->value;
+            break;
+        case OP_NUM_NE:
+            r = field_value(data, insn->offset) != insn->value;
+            break;
+        case OP_NUM_LT:
+            r = field_value(data, insn->offset) < insn->value;
+            break;
+        case OP_NUM_LE:
+            r = field_value(data, insn->offset) <= insn->value;
+            break;
+        case OP_NUM_GT:
+            r = field_value(data, insn->offset) > insn->value;
+            break;
+        case OP_NUM_GE:
+            r = field_value(data, insn->offset) >= insn->value;
+            break;
+        case OP_STR_EQ:
+            r = strcmp(name, insn->text) == 0;
+            break;
+        case OP_STR_NE:
+            r = strcmp(name, insn->text) != 0;
+            break;
+        case OP_STR_LT:
+            r = strcmp(name, insn->text) < 0;
+            break;
+        case OP_STR_LE:
+            r = strcmp(name, insn->text) <= 0;
+            break;
+        case OP_STR_GT:
+            r = strcmp(name, insn->text) > 0;
+            break;
+        case OP_STR_GE:
+            r = strcmp(name, insn->text) >= 0;
+            break;
+        case OP_STR_PREFIX:
+            r = strncmp(name, insn->text, insn->len) == 0;
+            break;
+        case OP_STR_SUFFIX: {
+            size_t len = strlen(name);
+            r = len >= insn->len && memcmp(name + len - insn->len, insn->text,
+                                           insn->len) == 0;
+            break;
+        }
+        case OP_STR_CONTAINS:
+            r = strstr(name, insn->text) != NULL;
+            break;
+        case OP_NOT:
+            r = !r;
+            break;
+        case OP_JUMP_FALSE:
+            if(!r)
+                pc = insn->target;
+            break;
+        case OP_JUMP_TRUE:
+            if(r)
+                pc = insn->target;
+            break;
+        }
+    }
+    return r;
+}
+
+/* Functions definitions --------------------------------------------------- */
+
+Query_t* Query_Compile(const char* text, char* error, size_t errorSize) {
+    Query_Parser_t parser;
+
+    if(error && errorSize)
+        error[0] = 0;
+    if(!text)
+        return NULL;
+
+    memset(&parser, 0, sizeof(parser));
+    parser.text = text;
+    parser.p = text;
+    parser.error = error;
+    parser.errorSize = errorSize;
+    parser.query = calloc(1, sizeof(Query_t));
+    if(!parser.query)
+        return NULL;
+
+    parse_or(&parser);
+    skip_space(&parser);
+    if(!parser.failed && *parser.p)
+        fail(&parser, "expected and, or or end of query");
+    if(parser.failed) {
+        Query_Free(parser.query);
+        return NULL;
+    }
+    return parser.query;
+}
+
+void Query_Free(Query_t* query) {
+    if(!query)
+        return;
+    for(size_t i = 0; i < query->count; i++)
+        free(query->code[i].text);
+    free(query->code);
+    free(query);
+}
+
+bool Query_Match(const Query_t* query, const Data_t* data) {
+    if(!query || !data)
+        return false;
+    return run(query, data);
+}
+
+static bool query_predicate(const Data_t* data, void* context) {
+    return run(context, data);
+}
+
+size_t List_Query(List_t list, const Query_t* query,
+                  List_Query_Callback_t callback, void* context) {
+    size_t matches = 0;
+
+    if(!query)
+        return 0;
+    /* a lone name equality is answered by the Bloom filter when it misses */
+    if(query->count == 1 && query->code[0].opcode == OP_STR_EQ &&
+       !List_Maybe_Contains_Name(list, query->code[0].text))
+        return 0;
+
+    for(const List_Node_t* node = list.first; node; node = node->next) {
+        if(!run(query, &node->data))
+            continue;
+        matches++;
+        if(callback && !callback(&node->data, context))
+            break;
+    }
+    return matches;
+}
+
+size_t List_Remove_Query(List_t* const list, const Query_t* query) {
+    if(!query)
+        return 0;
+    return List_Remove_If(list, query_predicate, (void*)query);
+}
@@ -0,0 +1,89 @@
+/**
+ * @file       query.h
+ * @date       10/2026
+ * @brief      Filter queries over the items of a linear list
+ * **********************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * Query language:
+ *
+ *     query      := or
+ *     or         := and { ("or" | "||") and }
+ *     and        := not { ("and" | "&&") not }
+ *     not        := ("not" | "!") not | "(" query ")" | comparison
+ *     comparison := field operator value
+ *
+ * Fields are name, age, weight and height. Numeric fields compare with
+ * = == != < <= > >= against a number. The name compares with the same
+ * operators (byte-wise) and with ^= (starts with), $= (ends with) and
+ * *= (contains); its value is a word or a string in "" or ''. Keywords
+ * and field names are case insensitive, values are not. Example:
+ *
+ *     name ^= J and (age > 30 or height >= 190.5)
+ */
+
+#ifndef QUERY_H
+#define QUERY_H
+
+/* Public includes --------------------------------------------------------- */
+#include <stdbool.h>
+#include <stddef.h>
+#include "list.h"
+
+/** Compiled query */
+typedef struct Query_s Query_t;
+
+/**
+ * @brief Called by List_Query for every matching item
+ * @param data[in] - data of the matching item
+ * @param context[in] - context passed to List_Query
+ * @return Returns false to stop the query
+ */
+typedef bool (*List_Query_Callback_t)(const Data_t* data, void* context);
+
+/* Public query API -------------------------------------------------------- */
+/**
+ * @brief Parses a query and compiles it into a predicate program. Fields are
+ * resolved to offsets in Data_t and constants are converted here, so
+ * matching an item does not look at the text again.
+ * @param text[in] - query
+ * @param error[out] - if not NULL, receives a description of a syntax error
+ * @param errorSize[in] - size of the error buffer
+ * @return Returns the compiled query, which must be released by Query_Free,
+ * or NULL on a syntax error or when out of memory
+ */
+Query_t* Query_Compile(const char* text, char* error, size_t errorSize);
+
+/**
+ * @brief Releases a compiled query
+ */
+void Query_Free(Query_t* query);
+
+/**
+ * @brief Evaluates a compiled query on one record
+ */
+bool Query_Match(const Query_t* query, const Data_t* data);
+
+/**
+ * @brief Streams all items of the list matching the query, from the first
+ * one. The active item is not changed. A query "name = value" does not
+ * walk the list if its Bloom filter (bloom.h) rules the name out.
+ * @param list[in] - searched list
+ * @param query[in] - compiled query
+ * @param callback[in] - called for every match, NULL only counts matches
+ * @param context[in] - passed to the callback
+ * @return Returns the number of matches passed to the callback (including
+ * the one which stopped the query)
+ */
+size_t List_Query(List_t list, const Query_t* query,
+                  List_Query_Callback_t callback, void* context);
+
+/**
+ * @brief Removes all items of the list matching the query by List_Remove_If
+ * @param list[in] - list, with which the operation should be done
+ * @param query[in] - compiled query
+ * @return Returns the number of removed items
+ */
+size_t List_Remove_Query(List_t* const list, const Query_t* query);
+
+#endif /* QUERY_H */
@@ -0,0 +1,494 @@
+/**
+ * @file       server.c
+ * @date       10/2026
+ * @brief      Serves one shared linear list to many local clients over a
+ * UNIX domain socket
+ * ****************************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ */
+
+#if !defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 200809L
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+/* Private includes -------------------------------------------------------- */
+#include "server.h"
+
+#include <stdlib.h>
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "trace.h"
+
+/* Private types and constants --------------------------------------------- */
+#define SERVER_BACKLOG 128
+#define SERVER_EVENTS 64
+/** Run loop wakes up at least this often to check the stop flag */
+#define SERVER_RUN_TIMEOUT_MS 100
+/** Input buffer of a connection, holds many pipelined requests */
+#define SERVER_IN_SIZE (16u * 1024u)
+/** Output buffer of a connection, responses are sent in one write */
+#define SERVER_OUT_SIZE (16u * 1024u)
+/** Largest request and response */
+#define SERVER_MESSAGE_MAX (1 + DATA_ENCODED_MAX)
+
+typedef struct Server_Conn_s {
+    int fd;
+    List_Node_t* cursor;      /**< active item of this client */
+    unsigned char in[SERVER_IN_SIZE];
+    size_t inUsed;
+    unsigned char out[SERVER_OUT_SIZE];
+    size_t outUsed;
+    uint32_t events;          /**< events registered in epoll */
+    bool eof;                 /**< client will send no more requests */
+    bool bad;                 /**< malformed request, close after flush */
+    struct Server_Conn_s* prev;
+    struct Server_Conn_s* next;
+} Server_Conn_t;
+
+struct Server_s {
+    List_t* list;
+    int listenFd;
+    int epollFd;
+    char* path;
+    Server_Conn_t* conns;
+};
+
+/* Private functions ------------------------------------------------------- */
+
+static bool set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+static void conn_close(Server_t* server, Server_Conn_t* conn) {
+    epoll_ctl(server->epollFd, EPOLL_CTL_DEL, conn->fd, NULL);
+    close(conn->fd);
+    if(conn->prev)
+        conn->prev->next = conn->next;
+    else
+        server->conns = conn->next;
+    if(conn->next)
+        conn->next->prev = conn->prev;
+    free(conn);
+}
+
+static void accept_all(Server_t* server) {
+    for(;;) {
+        struct epoll_event ev;
+        Server_Conn_t* conn;
+        int fd = accept(server->listenFd, NULL, NULL);
+
+        if(fd < 0) {
+            if(errno == EINTR)
+                continue;
+            return; /* EAGAIN or out of descriptors, try on next event */
+        }
+
+        conn = malloc(sizeof(*conn));
+        if(!conn || !set_nonblocking(fd)) {
+            free(conn);
+            close(fd);
+            continue;
+        }
+        conn->fd = fd;
+        conn->cursor = NULL;
+        conn->inUsed = 0;
+        conn->outUsed = 0;
+        conn->events = EPOLLIN;
+        conn->eof = false;
+        conn->bad = false;
+        conn->prev = NULL;
+        conn->next = server->conns;
+
+        memset(&ev, 0, sizeof(ev));
+        ev.events = conn->events;
+        ev.data.ptr = conn;
+        if(epoll_ctl(server->epollFd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            free(conn);
+            close(fd);
+            continue;
+        }
+        if(server->conns)
+            server->conns->prev = conn;
+        server->conns = conn;
+    }
+}
+
+/**
+ * @brief Resets every cursor that points at an item which is about to be
+ * freed
+ */
+static void cursors_forget(Server_t* server, const List_Node_t* node) {
+    for(Server_Conn_t* c = server->conns; c; c = c->next) {
+        if(c->cursor == node)
+            c->cursor = NULL;
+    }
+}
+
+static void list_clear(Server_t* server) {
+    while(server->list->first)
+        List_Delete_First(server->list);
+    List_Init(server->list);
+    for(Server_Conn_t* c = server->conns; c; c = c->next)
+        c->cursor = NULL;
+}
+
+/**
+ * @brief Executes one request against the shared list with the cursor of
+ * the connection and writes its response
+ * @return Returns the length of the response
+ */
+static size_t execute(Server_t* server, Server_Conn_t* conn, Trace_Op_t op,
+                      const Data_t* data, unsigned char* out) {
+    List_t* list = server->list;
+    List_Node_t* victim = NULL;
+    Data_t copy;
+    unsigned char status = SERVER_STATUS_OK;
+    size_t len = 1;
+
+    list->active = conn->cursor;
+    switch(op) {
+    case TRACE_OP_INIT:
+        list_clear(server);
+        break;
+    case TRACE_OP_ACTUALIZE:
+        if(list->active)
+            List_Actualize(list, *data);
+        else
+            status = SERVER_STATUS_FALSE;
+        break;
+    case TRACE_OP_INSERT_FIRST:
+        if(!List_Insert_After(list, NULL, *data))
+            status = SERVER_STATUS_ERROR;
+        break;
+    case TRACE_OP_FIRST:
+        List_First(list);
+        if(!list->active)
+            status = SERVER_STATUS_FALSE;
+        break;
+    case TRACE_OP_COPY_FIRST:
+        if(List_Copy_First(*list, &copy)) {
+            status = SERVER_STATUS_RECORD;
+            len += Data_Encode(&copy, out + 1);
+        } else {
+            status = SERVER_STATUS_FALSE;
+        }
+        break;
+    case TRACE_OP_DELETE_FIRST:
+        victim = list->first;
+        if(victim)
+            List_Delete_First(list);
+        else
+            status = SERVER_STATUS_FALSE;
+        break;
+    case TRACE_OP_POST_DELETE:
+        victim = list->active ? list->active->next : NULL;
+        if(victim)
+            List_Post_Delete(list);
+        else
+            status = SERVER_STATUS_FALSE;
+        break;
+    case TRACE_OP_POST_INSERT:
+        if(!list->active)
+            status = SERVER_STATUS_FALSE;
+        else if(!List_Insert_After(list, list->active, *data))
+            status = SERVER_STATUS_ERROR;
+        break;
+    case TRACE_OP_COPY:
+        if(List_Copy(*list, &copy)) {
+            status = SERVER_STATUS_RECORD;
+            len += Data_Encode(&copy, out + 1);
+        } else {
+            status = SERVER_STATUS_FALSE;
+        }
+        break;
+    case TRACE_OP_SUCC:
+        List_Succ(list);
+        if(!list->active)
+            status = SERVER_STATUS_FALSE;
+        break;
+    case TRACE_OP_IS_ACTIVE:
+        if(!List_Is_Active(*list))
+            status = SERVER_STATUS_FALSE;
+        break;
+    default:
+        status = SERVER_STATUS_BAD;
+        break;
+    }
+    conn->cursor = list->active;
+    if(victim)
+        cursors_forget(server, victim);
+    out[0] = status;
+    return len;
+}
+
+/**
+ * @brief Executes complete requests from the input buffer while there is
+ * room for their responses
+ */
+static void conn_process(Server_t* server, Server_Conn_t* conn) {
+    size_t pos = 0;
+
+    while(!conn->bad && pos < conn->inUsed &&
+          SERVER_OUT_SIZE - conn->outUsed >= SERVER_MESSAGE_MAX) {
+        const unsigned char* req = conn->in + pos;
+        size_t avail = conn->inUsed - pos;
+        unsigned char* out = conn->out + conn->outUsed;
+        Trace_Op_t op = (Trace_Op_t)req[0];
+        Data_t data;
+        size_t used = 1;
+
+        if(req[0] >= TRACE_OP_COUNT) {
+            out[0] = SERVER_STATUS_BAD;
+            conn->outUsed++;
+            conn->bad = true;
+            break;
+        }
+        if(Trace_Op_Has_Data(op)) {
+            size_t decoded = Data_Decode(req + 1, avail - 1, &data);
+            if(!decoded) {
+                /* name length 255 never fits Data_t, anything else is
+                 * just an incomplete request */
+                if(avail > 1 && req[1] >= sizeof(data.name)) {
+                    out[0] = SERVER_STATUS_BAD;
+                    conn->outUsed++;
+                    conn->bad = true;
+                }
+                break;
+            }
+            used += decoded;
+        }
+        conn->outUsed += execute(server, conn, op, &data, out);
+        pos += used;
+    }
+
+    if(pos) {
+        memmove(conn->in, conn->in + pos, conn->inUsed - pos);
+        conn->inUsed -= pos;
+    }
+}
+
+/**
+ * @return Returns false if the connection failed
+ */
+static bool conn_flush(Server_Conn_t* conn) {
+    size_t sent = 0;
+
+    while(sent < conn->outUsed) {
+        ssize_t n = send(conn->fd, conn->out + sent, conn->outUsed - sent,
+                         MSG_NOSIGNAL);
+        if(n < 0) {
+            if(errno == EINTR)
+                continue;
+            if(errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            return false;
+        }
+        sent += (size_t)n;
+    }
+    if(sent) {
+        memmove(conn->out, conn->out + sent, conn->outUsed - sent);
+        conn->outUsed -= sent;
+    }
+    return true;
+}
+
+/**
+ * @return Returns false if the connection failed
+ */
+static bool conn_read(Server_Conn_t* conn) {
+    for(;;) {
+        ssize_t n = read(conn->fd, conn->in + conn->inUsed,
+                         SERVER_IN_SIZE - conn->inUsed);
+        if(n < 0) {
+            if(errno == EINTR)
+                continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        if(n == 0)
+            conn->eof = true;
+        conn->inUsed += (size_t)n;
+        return true;
+    }
+}
+
+static void conn_handle(Server_t* server, Server_Conn_t* conn, uint32_t events) {
+    struct epoll_event ev;
+    uint32_t wanted = 0;
+    bool ok = true;
+
+    if(events & EPOLLOUT)
+        ok = conn_flush(conn);
+    if(ok && (events & (EPOLLIN | EPOLLHUP | EPOLLERR)) && !conn->eof &&
+       conn->inUsed < SERVER_IN_SIZE)
+        ok = conn_read(conn);
+    if(ok) {
+        conn_process(server, conn);
+        ok = conn_flush(conn);
+    }
+    if(!ok) {
+        conn_close(server, conn);
+        return;
+    }
+
+    /* reading stops while responses cannot be stored, so a client that
+     * does not read its responses cannot make the server buffer them */
+    if(!conn->eof && !conn->bad && conn->inUsed < SERVER_IN_SIZE &&
+       SERVER_OUT_SIZE - conn->outUsed >= SERVER_MESSAGE_MAX)
+        wanted |= EPOLLIN;
+    if(conn->outUsed)
+        wanted |= EPOLLOUT;
+    if(!wanted) {
+        conn_close(server, conn);
+        return;
+    }
+    if(wanted != conn->events) {
+        memset(&ev, 0, sizeof(ev));
+        ev.events = wanted;
+        ev.data.ptr = conn;
+        if(epoll_ctl(server->epollFd, EPOLL_CTL_MOD, conn->fd, &ev) != 0) {
+            conn_close(server, conn);
+            return;
+        }
+        conn->events = wanted;
+    }
+}
+
+/* Functions definitions --------------------------------------------------- */
+
+Server_t* Server_Open(List_t* const list, const char* path) {
+    struct sockaddr_un addr;
+    struct epoll_event ev;
+    struct stat st;
+    Server_t* server;
+
+    if(!list || !path || strlen(path) >= sizeof(addr.sun_path))
+        return NULL;
+
+    server = malloc(sizeof(*server));
+    if(!server)
+        return NULL;
+    server->list = list;
+    server->conns = NULL;
+    server->epollFd = -1;
+    server->path = malloc(strlen(path) + 1);
+    server->listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(!server->path || server->listenFd < 0)
+        goto fail;
+    strcpy(server->path, path);
+
+    if(lstat(path, &st) == 0 && S_ISSOCK(st.st_mode))
+        unlink(path);
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    if(bind(server->listenFd, (struct sockaddr*)&addr, sizeof(addr)) != 0)
+        goto fail;
+    if(listen(server->listenFd, SERVER_BACKLOG) != 0 ||
+       !set_nonblocking(server->listenFd)) {
+        unlink(path);
+        goto fail;
+    }
+
+    server->epollFd = epoll_create1(0);
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = NULL;
+    if(server->epollFd < 0 ||
+       epoll_ctl(server->epollFd, EPOLL_CTL_ADD, server->listenFd, &ev) != 0) {
+        unlink(path);
+        goto fail;
+    }
+    list->active = NULL;
+    return server;
+
+fail:
+    if(server->epollFd >= 0)
+        close(server->epollFd);
+    if(server->listenFd >= 0)
+        close(server->listenFd);
+    free(server->path);
+    free(server);
+    return NULL;
+}
+
+int Server_Poll(Server_t* server, int timeoutMs) {
+    struct epoll_event events[SERVER_EVENTS];
+    int n;
+
+    if(!server)
+        return -1;
+
+    n = epoll_wait(server->epollFd, events, SERVER_EVENTS, timeoutMs);
+    if(n < 0)
+        return errno == EINTR ? 0 : -1;
+
+    for(int i = 0; i < n; i++) {
+        if(events[i].data.ptr)
+            conn_handle(server, events[i].data.ptr, events[i].events);
+        else
+            accept_all(server);
+    }
+    return n;
+}
+
+bool Server_Run(Server_t* server, volatile sig_atomic_t* stop) {
+    if(!server)
+        return false;
+
+    while(!stop || !*stop) {
+        if(Server_Poll(server, SERVER_RUN_TIMEOUT_MS) < 0)
+            return false;
+    }
+    return true;
+}
+
+void Server_Close(Server_t* server) {
+    if(!server)
+        return;
+
+    while(server->conns)
+        conn_close(server, server->conns);
+    close(server->epollFd);
+    close(server->listenFd);
+    unlink(server->path);
+    server->list->active = NULL;
+    free(server->path);
+    free(server);
+}
+
+#else /* !__linux__ */
+
+Server_t* Server_Open(List_t* const list, const char* path) {
+    (void)list;
+    (void)path;
+    return NULL;
+}
+
+int Server_Poll(Server_t* server, int timeoutMs) {
+    (void)server;
+    (void)timeoutMs;
+    return -1;
+}
+
+bool Server_Run(Server_t* server, volatile sig_atomic_t* stop) {
+    (void)server;
+    (void)stop;
+    return false;
+}
+
+void Server_Close(Server_t* server) {
+    (void)server;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,84 @@
+/**
+ * @file       server.h
+ * @date       10/2026
+ * @brief      Serves one shared linear list to many local clients over a
+ * UNIX domain socket
+ * **********************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * Protocol (all numbers in the byte order of the host):
+ *
+ * A request is one byte with the Trace_Op_t code of the operation
+ * (the commands 0-9, A of the menu). Actualize, Insert_First and
+ * Post_Insert are followed by the record encoded by Data_Encode, exactly
+ * as in a trace file. A response is one status byte:
+ *
+ * | status                  | meaning                                   |
+ * |-------------------------|-------------------------------------------|
+ * | #SERVER_STATUS_OK       | operation done, Is_Active is true         |
+ * | #SERVER_STATUS_FALSE    | nothing to do (no active or first item),  |
+ * |                         | Is_Active is false                        |
+ * | #SERVER_STATUS_RECORD   | followed by a Data_Encode record (Copy,   |
+ * |                         | Copy_First)                               |
+ * | #SERVER_STATUS_ERROR    | item could not be allocated               |
+ * | #SERVER_STATUS_BAD      | malformed request, connection is closed   |
+ *
+ * Clients may pipeline any number of requests, responses come back in the
+ * order of the requests. Every connection has its own active item (cursor);
+ * the list itself is shared. A cursor pointing at an item deleted by
+ * another client is reset to no active item. Init deletes all items and
+ * resets the cursors of all connections.
+ */
+
+#ifndef SERVER_H
+#define SERVER_H
+
+/* Public includes --------------------------------------------------------- */
+#include <signal.h>
+#include <stdbool.h>
+#include "list.h"
+
+#define SERVER_STATUS_OK 0
+#define SERVER_STATUS_FALSE 1
+#define SERVER_STATUS_RECORD 2
+#define SERVER_STATUS_ERROR 3
+#define SERVER_STATUS_BAD 4
+
+/** Opaque server state */
+typedef struct Server_s Server_t;
+
+/* Public server API ------------------------------------------------------- */
+/**
+ * @brief Creates the listening socket and the event loop. A stale socket
+ * left at the path by a previous server is replaced, any other file is not.
+ * Only available on Linux (epoll).
+ * @param list[in] - list shared by all clients, must outlive the server
+ * @param path[in] - path of the UNIX domain socket
+ * @return Returns the server or NULL on failure
+ */
+Server_t* Server_Open(List_t* const list, const char* path);
+
+/**
+ * @brief Waits for socket events and handles them: accepts new clients,
+ * executes all complete requests and sends the responses.
+ * @param server[in] - server
+ * @param timeoutMs[in] - maximal time to wait, -1 waits forever
+ * @return Returns the number of handled events, 0 after a timeout or a
+ * signal and -1 on failure
+ */
+int Server_Poll(Server_t* server, int timeoutMs);
+
+/**
+ * @brief Calls Server_Poll until the stop flag is set (typically by a signal
+ * handler) or polling fails
+ * @return Returns false if polling failed
+ */
+bool Server_Run(Server_t* server, volatile sig_atomic_t* stop);
+
+/**
+ * @brief Closes all connections and the socket and removes the socket file.
+ * Items of the list are left untouched, its active item is reset.
+ */
+void Server_Close(Server_t* server);
+
+#endif /* SERVER_H */
@@ -0,0 +1,402 @@
+/**
+ * @file       sketch.c
+ * @date       10/2026
+ * @brief      Quantile sketches with relative error, kept up to date by the
+ * list operations
+ * ****************************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * The bucket of a value is computed from the bits of the double: the
+ * exponent gives the octave and the top of the mantissa the position in
+ * it, so neither a logarithm nor libm is needed. Bucket i of octave e spans
+ * [2^e (1 + i/c), 2^e (1 + (i+1)/c)) and is represented by the harmonic mean
+ * of its bounds, which is within 1 / (2c + 1) of every value in it. A store
+ * keeps the counts of a contiguous range of buckets and doubles when a value
+ * falls outside, leaving room on the side it grew to.
+ */
+
+/* Private includes -------------------------------------------------------- */
+#include "sketch.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "list_ext.h"
+
+/* Private types and constants --------------------------------------------- */
+#define SKETCH_MIN_BUCKETS 64u
+/** Finest accuracy, about 7.6e-6, keeps bucket indices within 2^27 */
+#define SKETCH_MAX_PER_OCTAVE (1 << 16)
+#define SKETCH_FIELDS 3
+#define MANTISSA_BITS 52
+#define MANTISSA_MASK (((uint64_t)1 << MANTISSA_BITS) - 1)
+#define EXPONENT_MASK 0x7ffu
+#define EXPONENT_BIAS 1023
+
+struct List_Sketch_s {
+    Sketch_t fields[SKETCH_FIELDS]; /**< age, weight and height */
+    bool valid;                     /**< false once an update failed */
+};
+
+/* Private functions ------------------------------------------------------- */
+
+static uint64_t double_bits(double value) {
+    uint64_t bits;
+
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/** Returns 2^exponent for a normal exponent */
+static double power_of_two(int32_t exponent) {
+    uint64_t bits = (uint64_t)(exponent + EXPONENT_BIAS) << MANTISSA_BITS;
+    double value;
+
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/** Returns the bucket of a magnitude with a biased exponent between 1 and 2046 */
+static int32_t bucket_of(const Sketch_t* sketch, uint64_t bits) {
+    int32_t exponent = (int32_t)((bits >> MANTISSA_BITS) & EXPONENT_MASK) - EXPONENT_BIAS;
+    double fraction = (double)(bits & MANTISSA_MASK) / (double)((uint64_t)1 << MANTISSA_BITS);
+    int32_t position = (int32_t)(fraction * sketch->perOctave);
+
+    if(position >= sketch->perOctave)
+        position = sketch->perOctave - 1;
+    return exponent * sketch->perOctave + position;
+}
+
+/** Returns the value representing a bucket */
+static double bucket_value(const Sketch_t* sketch, int32_t bucket) {
+    int32_t c = sketch->perOctave;
+    int32_t exponent = bucket / c;
+    double position;
+
+    if(bucket % c < 0)
+        exponent--;
+    position = (double)(bucket - exponent * c);
+    /* harmonic mean of 2^e (c + i) / c and 2^e (c + i + 1) / c */
+    return power_of_two(exponent) * ((c + position) / c) *
+           (2 * (c + position + 1) / (2 * (c + position) + 1));
+}
+
+static bool store_ensure(Sketch_Store_t* store, int32_t bucket) {
+    int64_t low = bucket, high = bucket, offset;
+    uint64_t length = store->length * 2;
+    uint64_t* counts;
+
+    if(store->length) {
+        if(bucket >= store->offset && (int64_t)bucket < (int64_t)store->offset + store->length)
+            return true;
+        if(store->offset < low)
+            low = store->offset;
+        if((int64_t)store->offset + store->length - 1 > high)
+            high = (int64_t)store->offset + store->length - 1;
+    }
+    if(length < SKETCH_MIN_BUCKETS)
+        length = SKETCH_MIN_BUCKETS;
+    while(length < (uint64_t)(high - low + 1))
+        length *= 2;
+
+    if(!store->length)
+        offset = bucket - (int64_t)length / 2;
+    else if(bucket < store->offset)
+        offset = high - (int64_t)length + 1;
+    else
+        offset = low;
+    counts = calloc((size_t)length, sizeof(uint64_t));
+    if(!counts)
+        return false;
+    if(store->length)
+        memcpy(counts + (store->offset - offset), store->counts,
+               store->length * sizeof(uint64_t));
+    free(store->counts);
+    store->counts = counts;
+    store->offset = (int32_t)offset;
+    store->length = (uint32_t)length;
+    return true;
+}
+
+static bool store_add(Sketch_Store_t* store, int32_t bucket, uint64_t count) {
+    if(!store_ensure(store, bucket))
+        return false;
+    store->counts[bucket - store->offset] += count;
+    return true;
+}
+
+static bool store_merge(Sketch_Store_t* into, const Sketch_Store_t* from) {
+    int32_t low = -1, high = -1;
+
+    for(uint32_t i = 0; i < from->length; i++) {
+        if(from->counts[i]) {
+            if(low < 0)
+                low = (int32_t)i;
+            high = (int32_t)i;
+        }
+    }
+    if(low < 0)
+        return true;
+    if(!store_ensure(into, from->offset + low) || !store_ensure(into, from->offset + high))
+        return false;
+    for(int32_t i = low; i <= high; i++)
+        into->counts[from->offset + i - into->offset] += from->counts[i];
+    return true;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+
+    return (x > y) - (x < y);
+}
+
+static bool is_finite(double value) {
+    return ((double_bits(value) >> MANTISSA_BITS & EXPONENT_MASK) != EXPONENT_MASK);
+}
+
+static double field_of(const Data_t* data, int field) {
+    switch(field) {
+    case 0:
+        return data->age;
+    case 1:
+        return data->weight;
+    default:
+        return data->height;
+    }
+}
+
+/** Returns the index of a numeric field in List_Sketch_s, -1 for others */
+static int field_index(Data_Field_t field) {
+    switch(field) {
+    case DATA_FIELD_AGE:
+        return 0;
+    case DATA_FIELD_WEIGHT:
+        return 1;
+    case DATA_FIELD_HEIGHT:
+        return 2;
+    default:
+        return -1;
+    }
+}
+
+/** Exact q-quantile by sorting the finite values of the field */
+static bool exact_quantile(List_t list, int field, double q, double* value) {
+    double* values;
+    size_t count = 0;
+
+    for(const List_Node_t* node = list.first; node; node = node->next)
+        count += is_finite(field_of(&node->data, field));
+    if(!count)
+        return false;
+    values = malloc(count * sizeof(double));
+    if(!values)
+        return false;
+    count = 0;
+    for(const List_Node_t* node = list.first; node; node = node->next) {
+        double v = field_of(&node->data, field);
+
+        if(is_finite(v))
+            values[count++] = v;
+    }
+    qsort(values, count, sizeof(double), compare_doubles);
+    *value = values[(size_t)(q * (double)(count - 1))];
+    free(values);
+    return true;
+}
+
+static void list_sketch_free(List_Sketch_t* sketch) {
+    for(int i = 0; i < SKETCH_FIELDS; i++)
+        Sketch_Free(&sketch->fields[i]);
+    free(sketch);
+}
+
+/* Functions definitions --------------------------------------------------- */
+
+bool Sketch_Init(Sketch_t* sketch, double accuracy) {
+    double perOctave;
+
+    if(!sketch || !(accuracy > 0 && accuracy < 1))
+        return false;
+    /* a bucket spanning 1 + 1/c has a relative error of 1 / (2c + 1) */
+    perOctave = (1 - accuracy) / (2 * accuracy);
+    if(perOctave > SKETCH_MAX_PER_OCTAVE)
+        return false;
+    memset(sketch, 0, sizeof(*sketch));
+    sketch->perOctave = (int32_t)perOctave;
+    if(sketch->perOctave < perOctave || !sketch->perOctave)
+        sketch->perOctave++;
+    return true;
+}
+
+void Sketch_Free(Sketch_t* sketch) {
+    if(!sketch)
+        return;
+    free(sketch->positive.counts);
+    free(sketch->negative.counts);
+    memset(&sketch->positive, 0, sizeof(sketch->positive));
+    memset(&sketch->negative, 0, sizeof(sketch->negative));
+    sketch->zero = 0;
+    sketch->count = 0;
+}
+
+bool Sketch_Add(Sketch_t* sketch, double value) {
+    uint64_t bits;
+    uint32_t exponent;
+
+    if(!sketch)
+        return false;
+    bits = double_bits(value);
+    exponent = (uint32_t)(bits >> MANTISSA_BITS) & EXPONENT_MASK;
+    if(exponent == EXPONENT_MASK)
+        return true;
+    if(!exponent)
+        sketch->zero++;
+    else if(!store_add(value > 0 ? &sketch->positive : &sketch->negative,
+                       bucket_of(sketch, bits), 1))
+        return false;
+    sketch->count++;
+    return true;
+}
+
+void Sketch_Remove(Sketch_t* sketch, double value) {
+    Sketch_Store_t* store;
+    uint64_t bits;
+    uint32_t exponent;
+    int64_t i;
+
+    if(!sketch)
+        return;
+    bits = double_bits(value);
+    exponent = (uint32_t)(bits >> MANTISSA_BITS) & EXPONENT_MASK;
+    if(exponent == EXPONENT_MASK)
+        return;
+    if(!exponent) {
+        if(sketch->zero) {
+            sketch->zero--;
+            sketch->count--;
+        }
+        return;
+    }
+    store = value > 0 ? &sketch->positive : &sketch->negative;
+    i = (int64_t)bucket_of(sketch, bits) - store->offset;
+    if(i >= 0 && i < (int64_t)store->length && store->counts[i]) {
+        store->counts[i]--;
+        sketch->count--;
+    }
+}
+
+bool Sketch_Merge(Sketch_t* into, const Sketch_t* from) {
+    if(!into || !from || into->perOctave != from->perOctave)
+        return false;
+    if(!store_merge(&into->positive, &from->positive) ||
+       !store_merge(&into->negative, &from->negative))
+        return false;
+    into->zero += from->zero;
+    into->count += from->count;
+    return true;
+}
+
+bool Sketch_Quantile(const Sketch_t* sketch, double q, double* value) {
+    uint64_t rank, seen = 0;
+
+    if(!sketch || !value || !sketch->count || !(q >= 0 && q <= 1))
+        return false;
+    rank = (uint64_t)(q * (double)(sketch->count - 1));
+
+    /* the largest magnitudes of negative values come first */
+    for(uint32_t i = sketch->negative.length; i-- > 0;) {
+        seen += sketch->negative.counts[i];
+        if(seen > rank) {
+            *value = -bucket_value(sketch, sketch->negative.offset + (int32_t)i);
+            return true;
+        }
+    }
+    seen += sketch->zero;
+    if(seen > rank) {
+        *value = 0;
+        return true;
+    }
+    for(uint32_t i = 0; i < sketch->positive.length; i++) {
+        seen += sketch->positive.counts[i];
+        if(seen > rank) {
+            *value = bucket_value(sketch, sketch->positive.offset + (int32_t)i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool List_Sketch_Attach(List_t* const list, double accuracy) {
+    List_Ext_t* ext;
+    List_Sketch_t* sketch;
+
+    if(!list || (list->ext && list->ext->sketch))
+        return false;
+    sketch = calloc(1, sizeof(*sketch));
+    if(!sketch)
+        return false;
+    for(int i = 0; i < SKETCH_FIELDS; i++) {
+        if(!Sketch_Init(&sketch->fields[i], accuracy)) {
+            free(sketch);
+            return false;
+        }
+    }
+    sketch->valid = true;
+    for(const List_Node_t* node = list->first; node && sketch->valid; node = node->next)
+        List_Sketch_Add(sketch, &node->data);
+    ext = sketch->valid ? List_Ext_Get(list) : NULL;
+    if(!ext) {
+        list_sketch_free(sketch);
+        return false;
+    }
+    ext->sketch = sketch;
+    return true;
+}
+
+void List_Sketch_Detach(List_t* const list) {
+    if(!list || !list->ext || !list->ext->sketch)
+        return;
+    list_sketch_free(list->ext->sketch);
+    list->ext->sketch = NULL;
+    List_Ext_Release(list);
+}
+
+const Sketch_t* List_Sketch(List_t list, Data_Field_t field) {
+    int index = field_index(field);
+    List_Sketch_t* sketch = list.ext ? list.ext->sketch : NULL;
+
+    if(index < 0 || !sketch || !sketch->valid)
+        return NULL;
+    return &sketch->fields[index];
+}
+
+bool List_Quantile(List_t list, Data_Field_t field, double q, double* value) {
+    int index = field_index(field);
+    List_Sketch_t* sketch = list.ext ? list.ext->sketch : NULL;
+
+    if(index < 0 || !value || !(q >= 0 && q <= 1))
+        return false;
+    if(sketch && sketch->valid)
+        return Sketch_Quantile(&sketch->fields[index], q, value);
+    return exact_quantile(list, index, q, value);
+}
+
+void List_Sketch_Add(List_Sketch_t* sketch, const Data_t* data) {
+    if(!sketch->valid)
+        return;
+    for(int i = 0; i < SKETCH_FIELDS; i++) {
+        if(!Sketch_Add(&sketch->fields[i], field_of(data, i))) {
+            /* the counts are off from now on, release them */
+            for(int j = 0; j < SKETCH_FIELDS; j++)
+                Sketch_Free(&sketch->fields[j]);
+            sketch->valid = false;
+            return;
+        }
+    }
+}
+
+void List_Sketch_Remove(List_Sketch_t* sketch, const Data_t* data) {
+    if(!sketch->valid)
+        return;
+    for(int i = 0; i < SKETCH_FIELDS; i++)
+        Sketch_Remove(&sketch->fields[i], field_of(data, i));
+}
@@ -0,0 +1,148 @@
+/**
+ * @file       sketch.h
+ * @date       10/2026
+ * @brief      Quantile sketches with relative error, kept up to date by the
+ * list operations
+ * **********************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * A Sketch_t counts values in logarithmic buckets (DDSketch): a value x > 0
+ * falls into bucket floor(c * log2'(x)), where log2' interpolates linearly
+ * between powers of two, so one bucket spans at most a factor of 1 + 1/c.
+ * Any quantile is answered from the bucket counts with a relative error
+ * of at most 1 / (2c + 1), whatever the distribution. Unlike sampling
+ * sketches, a value can be removed again by decrementing its bucket, which
+ * is what a list with deletes and updates needs, and two sketches of the
+ * same accuracy merge by adding their counts.
+ *
+ * Attached to a list, one sketch per numeric field is updated by every
+ * insert, delete and List_Actualize, and List_Quantile answers from the
+ * sketch in time proportional to the number of buckets.
+ */
+
+#ifndef SKETCH_H
+#define SKETCH_H
+
+/* Public includes --------------------------------------------------------- */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "data.h"
+#include "list.h"
+
+/** @struct Sketch_Store_t
+ * Counts of a contiguous range of buckets
+ */
+typedef struct {
+  uint64_t* counts; /**< counts of the buckets offset ... offset + length - 1 */
+  int32_t offset;   /**< index of the bucket counts[0] */
+  uint32_t length;  /**< number of counts */
+} Sketch_Store_t;
+
+/** @struct Sketch_t
+ * Quantile sketch of one stream of values
+ */
+typedef struct {
+  Sketch_Store_t positive; /**< buckets of values above 0 */
+  Sketch_Store_t negative; /**< buckets of the magnitudes of values below 0 */
+  uint64_t zero;           /**< values closer to 0 than DBL_MIN */
+  uint64_t count;          /**< all counted values */
+  int32_t perOctave;       /**< buckets between two powers of two (c) */
+} Sketch_t;
+
+/* Public Sketch_t API ----------------------------------------------------- */
+/**
+ * @brief Initializes an empty sketch
+ * @param sketch[out] - the sketch
+ * @param accuracy[in] - relative error of the quantiles, between 0 and 1
+ * (0.01 for 1 %, which takes 50 buckets per power of two)
+ * @return Returns false for an invalid accuracy
+ */
+bool Sketch_Init(Sketch_t* sketch, double accuracy);
+
+/**
+ * @brief Releases the buckets of the sketch, which stays usable and empty
+ */
+void Sketch_Free(Sketch_t* sketch);
+
+/**
+ * @brief Counts a value, NaN and infinities are ignored
+ * @return Returns false if the buckets could not grow
+ */
+bool Sketch_Add(Sketch_t* sketch, double value);
+
+/**
+ * @brief Uncounts a value added before
+ */
+void Sketch_Remove(Sketch_t* sketch, double value);
+
+/**
+ * @brief Adds all values of one sketch to another
+ * @param into[in] - the sketch receiving the values
+ * @param from[in] - the sketch whose values are added
+ * @return Returns false if the accuracies differ or the buckets could not
+ * grow
+ */
+bool Sketch_Merge(Sketch_t* into, const Sketch_t* from);
+
+/**
+ * @brief Estimates the q-quantile of the counted values, the value of rank
+ * floor(q * (count - 1)) in sorted order
+ * @param q[in] - quantile between 0 and 1, 0.5 for the median
+ * @param value[out] - the estimate
+ * @return Returns false if the sketch is empty or q is out of range
+ */
+bool Sketch_Quantile(const Sketch_t* sketch, double q, double* value);
+
+/* Public list sketch API -------------------------------------------------- */
+/**
+ * @brief Creates sketches of age, weight and height, counts the current
+ * items and attaches them to the list. List_Free releases the sketches.
+ * @param list[in] - list, whose fields should be sketched
+ * @param accuracy[in] - relative error of the quantiles, between 0 and 1
+ * @return Returns false for an invalid accuracy, when out of memory or if
+ * sketches are already attached
+ */
+bool List_Sketch_Attach(List_t* const list, double accuracy);
+
+/**
+ * @brief Releases the sketches of the list, if any
+ * @param list[in] - list, whose sketches should be released
+ */
+void List_Sketch_Detach(List_t* const list);
+
+/**
+ * @brief Returns the sketch of a numeric field of the list, for example to
+ * merge the sketches of several lists
+ * @return Returns NULL for DATA_FIELD_NAME, if no sketches are attached or
+ * if they could not grow during an update and are no longer valid
+ */
+const Sketch_t* List_Sketch(List_t list, Data_Field_t field);
+
+/**
+ * @brief Returns the q-quantile of a numeric field of the list. With valid
+ * sketches attached the answer comes from the sketch, within its relative
+ * error; otherwise the values are collected and sorted, which gives the
+ * exact answer in O(n log n).
+ * @param list[in] - list, whose items are ranked
+ * @param field[in] - numeric field (not DATA_FIELD_NAME)
+ * @param q[in] - quantile between 0 and 1
+ * @param value[out] - the quantile
+ * @return Returns false if the list has no finite value of the field, for
+ * an invalid argument or when out of memory
+ */
+bool List_Quantile(List_t list, Data_Field_t field, double q, double* value);
+
+/* Sketch maintenance, called by list.c ------------------------------------ */
+/**
+ * @brief Counts the fields of an item; if the sketches can not grow they
+ * are marked invalid and List_Quantile falls back to sorting
+ */
+void List_Sketch_Add(List_Sketch_t* sketch, const Data_t* data);
+
+/**
+ * @brief Uncounts the fields of an item counted before
+ */
+void List_Sketch_Remove(List_Sketch_t* sketch, const Data_t* data);
+
+#endif /* SKETCH_H */
@@ -0,0 +1,313 @@
+/**
+ * @file       snapshot.c
+ * @date       10/2026
+ * @brief      Binary snapshots of a linear list
+ * ****************************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ */
+
+#if !defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 200809L
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+/* Private includes -------------------------------------------------------- */
+#include "snapshot.h"
+
+#include <stdlib.h>
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Private types and constants --------------------------------------------- */
+#define SNAPSHOT_MAGIC "LISTSNAP"
+#define SNAPSHOT_BOM 0x01020304u
+#define SNAPSHOT_NO_ACTIVE UINT64_MAX
+/** Size of one write, must be a multiple of 8 (see checksum_update) */
+#define SNAPSHOT_BUFFER_SIZE (1u << 20)
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t bom;
+    uint64_t count;
+    uint64_t active;
+    uint64_t payloadSize;
+    uint64_t checksum;
+} Snapshot_Header_t;
+
+typedef struct {
+    int fd;
+    unsigned char* buffer;
+    size_t used;
+    uint64_t checksum;
+    uint64_t written;
+    bool ok;
+} Snapshot_Writer_t;
+
+/* Private functions ------------------------------------------------------- */
+
+static uint64_t checksum_update(uint64_t h, const unsigned char* p, size_t len);
+
+/** Returns the checksum of the header: the payload checksum, then count and active */
+static uint64_t header_checksum(uint64_t payload, const Snapshot_Header_t* header) {
+    uint64_t fields[2];
+
+    fields[0] = header->count;
+    fields[1] = header->active;
+    return checksum_update(payload, (const unsigned char*)fields, sizeof(fields));
+}
+
+/**
+ * @brief Word-wise multiplicative checksum. Every block except the last one
+ * must have length divisible by 8, the last one is padded with zeros.
+ */
+static uint64_t checksum_update(uint64_t h, const unsigned char* p, size_t len) {
+    while(len >= 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        h = (h ^ w) * UINT64_C(0x9E3779B97F4A7C15);
+        h ^= h >> 29;
+        p += 8;
+        len -= 8;
+    }
+    if(len) {
+        uint64_t w = 0;
+        memcpy(&w, p, len);
+        h = (h ^ w) * UINT64_C(0x9E3779B97F4A7C15);
+        h ^= h >> 29;
+    }
+    return h;
+}
+
+static bool write_all(int fd, const void* data, size_t len) {
+    const char* p = data;
+    while(len) {
+        ssize_t n = write(fd, p, len);
+        if(n < 0) {
+            if(errno == EINTR)
+                continue;
+            return false;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+/** Makes the rename of a file in the directory of path durable */
+static bool sync_directory(const char* path) {
+    const char* slash = strrchr(path, '/');
+    char* dir;
+    bool ok;
+    int fd;
+
+    if(!slash)
+        dir = strdup(".");
+    else if(slash == path)
+        dir = strdup("/");
+    else
+        dir = strndup(path, (size_t)(slash - path));
+    if(!dir)
+        return false;
+    fd = open(dir, O_RDONLY);
+    free(dir);
+    if(fd < 0)
+        return false;
+    ok = fsync(fd) == 0;
+    close(fd);
+    return ok;
+}
+
+static void writer_flush(Snapshot_Writer_t* w) {
+    if(!w->used || !w->ok)
+        return;
+    w->checksum = checksum_update(w->checksum, w->buffer, w->used);
+    w->ok = write_all(w->fd, w->buffer, w->used);
+    w->written += w->used;
+    w->used = 0;
+}
+
+/**
+ * @brief Appends bytes to the buffer, records may be split between two
+ * blocks so that every block but the last one is completely full.
+ */
+static void writer_put(Snapshot_Writer_t* w, const unsigned char* p, size_t len) {
+    while(len && w->ok) {
+        size_t room = SNAPSHOT_BUFFER_SIZE - w->used;
+        size_t n = len < room ? len : room;
+        memcpy(w->buffer + w->used, p, n);
+        w->used += n;
+        p += n;
+        len -= n;
+        if(w->used == SNAPSHOT_BUFFER_SIZE)
+            writer_flush(w);
+    }
+}
+
+/* Functions definitions --------------------------------------------------- */
+
+bool List_Save(const List_t* const list, const char* path) {
+    Snapshot_Header_t header;
+    Snapshot_Writer_t w;
+    unsigned char record[DATA_ENCODED_MAX];
+    char* tmpPath;
+    uint64_t index = 0;
+
+    if(!list || !path)
+        return false;
+
+    tmpPath = malloc(strlen(path) + 5);
+    if(!tmpPath)
+        return false;
+    sprintf(tmpPath, "%s.tmp", path);
+
+    memset(&w, 0, sizeof(w));
+    w.ok = true;
+    w.buffer = malloc(SNAPSHOT_BUFFER_SIZE);
+    w.fd = open(tmpPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(!w.buffer || w.fd < 0) {
+        if(w.fd >= 0)
+            close(w.fd);
+        free(w.buffer);
+        free(tmpPath);
+        return false;
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.bom = SNAPSHOT_BOM;
+    header.active = SNAPSHOT_NO_ACTIVE;
+
+    /* header is rewritten with the real values once the payload is done */
+    w.ok = lseek(w.fd, sizeof(header), SEEK_SET) == (off_t)sizeof(header);
+    for(List_Node_t* node = list->first; node && w.ok; node = node->next) {
+        if(node == list->active)
+            header.active = index;
+        writer_put(&w, record, Data_Encode(&node->data, record));
+        index++;
+    }
+    writer_flush(&w);
+
+    header.count = index;
+    header.payloadSize = w.written;
+    header.checksum = header_checksum(w.checksum, &header);
+    if(w.ok)
+        w.ok = pwrite(w.fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header);
+    /* the data must be on the disk before the rename can replace the old file */
+    if(w.ok)
+        w.ok = fsync(w.fd) == 0;
+    if(close(w.fd) != 0)
+        w.ok = false;
+    if(w.ok)
+        w.ok = rename(tmpPath, path) == 0 && sync_directory(path);
+    if(!w.ok)
+        unlink(tmpPath);
+
+    free(w.buffer);
+    free(tmpPath);
+    return w.ok;
+}
+
+bool List_Load(List_t* const list, const char* path, size_t* count) {
+    Snapshot_Header_t header;
+    const unsigned char* map;
+    const unsigned char* p;
+    const unsigned char* end;
+    List_Node_t* last = NULL;
+    List_Node_t* active = NULL;
+    struct stat st;
+    size_t loaded = 0;
+    bool ok = true;
+    int fd;
+
+    if(count)
+        *count = 0;
+    if(!list || !path)
+        return false;
+
+    fd = open(path, O_RDONLY);
+    if(fd < 0)
+        return false;
+    if(fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(header)) {
+        close(fd);
+        return false;
+    }
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(map == MAP_FAILED)
+        return false;
+
+    memcpy(&header, map, sizeof(header));
+    p = map + sizeof(header);
+    end = map + st.st_size;
+    if(memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 ||
+       header.version != SNAPSHOT_VERSION || header.bom != SNAPSHOT_BOM ||
+       header.payloadSize != (uint64_t)(end - p) ||
+       header.count > header.payloadSize ||
+       (header.active != SNAPSHOT_NO_ACTIVE && header.active >= header.count) ||
+       header_checksum(checksum_update(0, p, (size_t)header.payloadSize), &header) !=
+           header.checksum) {
+        munmap((void*)map, (size_t)st.st_size);
+        return false;
+    }
+
+    posix_madvise((void*)map, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+    for(uint64_t i = 0; i < header.count; i++) {
+        List_Node_t* node = List_Node_Alloc(list);
+        size_t used;
+
+        if(!node) {
+            ok = false;
+            break;
+        }
+        used = Data_Decode(p, (size_t)(end - p), &node->data);
+        if(!used) {
+            List_Node_Free(list, node);
+            ok = false;
+            break;
+        }
+        p += used;
+        List_Link_After(list, last, node);
+        last = node;
+        if(i == header.active)
+            active = node;
+        loaded++;
+    }
+
+    if(ok && p != end)
+        ok = false;
+    if(ok && !list->active)
+        list->active = active;
+    munmap((void*)map, (size_t)st.st_size);
+    if(count)
+        *count = loaded;
+    return ok;
+}
+
+#else /* !__linux__ */
+
+bool List_Save(const List_t* const list, const char* path) {
+    (void)list;
+    (void)path;
+    return false;
+}
+
+bool List_Load(List_t* const list, const char* path, size_t* count) {
+    (void)list;
+    (void)path;
+    if(count)
+        *count = 0;
+    return false;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,60 @@
+/**
+ * @file       snapshot.h
+ * @date       10/2026
+ * @brief      Binary snapshots of a linear list
+ * **********************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * Snapshot file layout (all numbers in the byte order of the host):
+ *
+ * | offset | size | content                                         |
+ * |--------|------|-------------------------------------------------|
+ * | 0      | 8    | magic "LISTSNAP"                                |
+ * | 8      | 4    | format version (#SNAPSHOT_VERSION)              |
+ * | 12     | 4    | byte order mark 0x01020304                      |
+ * | 16     | 8    | number of records                               |
+ * | 24     | 8    | index of the active record, all ones if none    |
+ * | 32     | 8    | payload size in bytes                           |
+ * | 40     | 8    | checksum of the payload, then count and active  |
+ * | 48     | ...  | records encoded by Data_Encode                  |
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+/* Public includes --------------------------------------------------------- */
+#include <stdbool.h>
+#include <stddef.h>
+#include "list.h"
+
+/** Version of the snapshot format written by List_Save */
+#define SNAPSHOT_VERSION 2
+
+/* Public snapshot API ----------------------------------------------------- */
+/**
+ * @brief Saves all items of the list and the position of the active item into
+ * a binary snapshot. The file is written through a temporary file in large
+ * blocks, synced to the disk and renamed at the end, so an existing snapshot
+ * is never left half written, not even by a crash. Only available on Linux.
+ * @param list[in] - list, which should be saved
+ * @param path[in] - path of the snapshot file
+ * @return Returns true if the snapshot was written
+ */
+bool List_Save(const List_t* const list, const char* path);
+
+/**
+ * @brief Loads a snapshot written by List_Save. The file is mapped into
+ * memory, its header and the checksum, which covers the payload, the record
+ * count and the active record, are verified before any item is created.
+ * Loaded items are put at the start of the list in the saved order. If the
+ * list had no active item, the saved active item becomes active. Only
+ * available on Linux.
+ * @param list[in] - list, where to store the loaded items
+ * @param path[in] - path of the snapshot file
+ * @param count[out] - if not NULL, receives number of loaded records
+ * @return Returns false if the file could not be read, it is not a snapshot
+ * of a supported version, it is corrupted or an item could not be allocated
+ */
+bool List_Load(List_t* const list, const char* path, size_t* count);
+
+#endif /* SNAPSHOT_H */
@@ -0,0 +1,266 @@
+/**
+ * @file       topk.c
+ * @date       10/2026
+ * @brief      Top-k and bottom-k items of a linear list by a numeric field
+ * ****************************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * The heap keeps the k best items seen so far with the worst of them at the
+ * root, so every further item costs one comparison with the root and only
+ * the few that beat it a sift down. Bottom-k searches negate the values.
+ * Every entry carries its position in the list, which breaks ties in favour
+ * of the earlier item and makes the merged parallel result identical to the
+ * sequential one.
+ */
+
+#if !defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 200809L
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+/* Private includes -------------------------------------------------------- */
+#include "topk.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "order.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+/* Private types and constants --------------------------------------------- */
+#define TOPK_MAX_WORKERS 64
+/** Fewest items per chunk worth a thread of its own */
+#define TOPK_MIN_CHUNK 16384
+/** Entries allocated for the first item offered to a heap */
+#define TOPK_MIN_HEAP 64
+
+typedef struct {
+    double key;               /**< value of the field, negated for bottom-k */
+    size_t position;          /**< position of the item in the list */
+    const List_Node_t* node;
+} TopK_Entry_t;
+
+typedef struct {
+    TopK_Entry_t* entries;
+    size_t size;
+    size_t capacity;          /**< allocated entries, grown up to k */
+    size_t k;
+    bool failed;              /**< the entries could not grow */
+} TopK_Heap_t;
+
+typedef struct {
+    TopK_Heap_t heap;
+    const List_Node_t* start;
+    size_t position;          /**< position of start */
+    size_t count;             /**< items of the chunk */
+    size_t offset;            /**< offset of the field in Data_t */
+    bool largest;
+} TopK_Chunk_t;
+
+/* Private functions ------------------------------------------------------- */
+
+/** Tells whether a is ranked below b */
+static inline bool worse(const TopK_Entry_t* a, const TopK_Entry_t* b) {
+    return a->key < b->key || (a->key == b->key && a->position > b->position);
+}
+
+static void sift_down(TopK_Entry_t* entries, size_t size, size_t i) {
+    TopK_Entry_t entry = entries[i];
+
+    for(;;) {
+        size_t child = 2 * i + 1;
+
+        if(child >= size)
+            break;
+        if(child + 1 < size && worse(&entries[child + 1], &entries[child]))
+            child++;
+        if(!worse(&entries[child], &entry))
+            break;
+        entries[i] = entries[child];
+        i = child;
+    }
+    entries[i] = entry;
+}
+
+/** Makes room for one more entry, doubling the allocation up to k */
+static bool heap_reserve(TopK_Heap_t* heap) {
+    TopK_Entry_t* entries;
+    size_t capacity;
+
+    if(heap->size < heap->capacity)
+        return true;
+    capacity = heap->capacity ? 2 * heap->capacity : TOPK_MIN_HEAP;
+    if(capacity > heap->k)
+        capacity = heap->k;
+    entries = realloc(heap->entries, capacity * sizeof(TopK_Entry_t));
+    if(!entries) {
+        heap->failed = true;
+        return false;
+    }
+    heap->entries = entries;
+    heap->capacity = capacity;
+    return true;
+}
+
+static void heap_offer(TopK_Heap_t* heap, const TopK_Entry_t* entry) {
+    if(heap->size < heap->k) {
+        size_t i;
+
+        if(!heap_reserve(heap))
+            return;
+        i = heap->size++;
+
+        while(i && worse(entry, &heap->entries[(i - 1) / 2])) {
+            heap->entries[i] = heap->entries[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+        heap->entries[i] = *entry;
+    } else if(worse(&heap->entries[0], entry)) {
+        heap->entries[0] = *entry;
+        sift_down(heap->entries, heap->size, 0);
+    }
+}
+
+/** Sorts the heap in place from the best entry and stores the items */
+static size_t heap_drain(TopK_Heap_t* heap, const List_Node_t** out) {
+    for(size_t size = heap->size; size > 1; size--) {
+        TopK_Entry_t worst = heap->entries[0];
+
+        heap->entries[0] = heap->entries[size - 1];
+        heap->entries[size - 1] = worst;
+        sift_down(heap->entries, size - 1, 0);
+    }
+    for(size_t i = 0; i < heap->size; i++)
+        out[i] = heap->entries[i].node;
+    return heap->size;
+}
+
+static void scan(TopK_Chunk_t* chunk) {
+    const List_Node_t* node = chunk->start;
+    TopK_Entry_t entry;
+
+    for(size_t i = 0; node && i < chunk->count; i++, node = node->next) {
+        memcpy(&entry.key, (const char*)&node->data + chunk->offset, sizeof(entry.key));
+        if(entry.key != entry.key)
+            continue;
+        if(!chunk->largest)
+            entry.key = -entry.key;
+        if(chunk->heap.size == chunk->heap.k && entry.key <= chunk->heap.entries[0].key)
+            continue;
+        entry.position = chunk->position + i;
+        entry.node = node;
+        heap_offer(&chunk->heap, &entry);
+    }
+}
+
+#ifdef __linux__
+static void* scan_main(void* arg) {
+    scan(arg);
+    return NULL;
+}
+#endif
+
+static void chunk_init(TopK_Chunk_t* chunk, Data_Field_t field, size_t k, bool largest) {
+    memset(chunk, 0, sizeof(*chunk));
+    chunk->heap.k = k;
+    chunk->offset = Data_Field_Offset(field);
+    chunk->largest = largest;
+    chunk->count = (size_t)-1;
+}
+
+static bool valid_arguments(Data_Field_t field, size_t k, const List_Node_t** out) {
+    return out && k && k <= (size_t)-1 / sizeof(TopK_Entry_t) &&
+           (field == DATA_FIELD_AGE || field == DATA_FIELD_WEIGHT ||
+            field == DATA_FIELD_HEIGHT);
+}
+
+/* Functions definitions --------------------------------------------------- */
+
+size_t List_Top_K(List_t list, Data_Field_t field, size_t k, bool largest,
+                  const List_Node_t** out) {
+    TopK_Chunk_t chunk;
+    size_t count = 0;
+
+    if(!valid_arguments(field, k, out) || !list.first)
+        return 0;
+    chunk_init(&chunk, field, k, largest);
+    chunk.start = list.first;
+    scan(&chunk);
+    if(!chunk.heap.failed)
+        count = heap_drain(&chunk.heap, out);
+    free(chunk.heap.entries);
+    return count;
+}
+
+#ifdef __linux__
+
+size_t List_Top_K_Parallel(List_t list, Data_Field_t field, size_t k, bool largest,
+                           int workers, const List_Node_t** out) {
+    TopK_Chunk_t chunks[TOPK_MAX_WORKERS];
+    pthread_t threads[TOPK_MAX_WORKERS];
+    bool started[TOPK_MAX_WORKERS] = {false};
+    TopK_Heap_t merged = {NULL, 0, 0, k, false};
+    size_t length, count = 0;
+    int used = 0;
+
+    if(!valid_arguments(field, k, out) || !list.first)
+        return 0;
+    if(workers <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = cpus > 1 ? (int)cpus : 1;
+    }
+    if(workers > TOPK_MAX_WORKERS)
+        workers = TOPK_MAX_WORKERS;
+    length = List_Order_Attached(list) ? List_Length(list) : 0;
+    if((size_t)workers > length / TOPK_MIN_CHUNK)
+        workers = (int)(length / TOPK_MIN_CHUNK);
+    if(workers < 2)
+        return List_Top_K(list, field, k, largest, out);
+
+    /* cut the list with the index, chunk 0 is searched by this thread */
+    for(; used < workers; used++) {
+        TopK_Chunk_t* chunk = &chunks[used];
+        List_t cursor = list;
+
+        chunk_init(chunk, field, k, largest);
+        chunk->position = length / (size_t)workers * (size_t)used;
+        chunk->count = used + 1 < workers ? length / (size_t)workers
+                                          : length - chunk->position;
+        List_Seek(&cursor, chunk->position);
+        chunk->start = cursor.active;
+    }
+    for(int i = 1; i < used; i++)
+        started[i] = pthread_create(&threads[i], NULL, scan_main, &chunks[i]) == 0;
+    scan(&chunks[0]);
+    for(int i = 1; i < used; i++) {
+        if(started[i])
+            pthread_join(threads[i], NULL);
+        else
+            scan(&chunks[i]);
+    }
+
+    for(int i = 0; i < used; i++) {
+        merged.failed |= chunks[i].heap.failed;
+        for(size_t j = 0; j < chunks[i].heap.size; j++)
+            heap_offer(&merged, &chunks[i].heap.entries[j]);
+    }
+    if(!merged.failed)
+        count = heap_drain(&merged, out);
+    free(merged.entries);
+    for(int i = 0; i < used; i++)
+        free(chunks[i].heap.entries);
+    return count;
+}
+
+#else /* !__linux__ */
+
+size_t List_Top_K_Parallel(List_t list, Data_Field_t field, size_t k, bool largest,
+                           int workers, const List_Node_t** out) {
+    (void)workers;
+    return List_Top_K(list, field, k, largest, out);
+}
+
+#endif /* __linux__ */
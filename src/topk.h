@@ -0,0 +1,54 @@
+/**
+ * @file       topk.h
+ * @date       10/2026
+ * @brief      Top-k and bottom-k items of a linear list by a numeric field
+ * **********************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * The k items with the largest (or smallest) value of a field are found in
+ * one pass over the list with a bounded binary heap, in O(n log k) time and
+ * O(k) memory, instead of sorting all n items. The result is an array of
+ * pointers at the items, no Data_t is copied. The pointers are valid until
+ * the items are deleted.
+ */
+
+#ifndef TOPK_H
+#define TOPK_H
+
+/* Public includes --------------------------------------------------------- */
+#include <stdbool.h>
+#include <stddef.h>
+#include "data.h"
+#include "list.h"
+
+/* Public top-k API -------------------------------------------------------- */
+/**
+ * @brief Finds the k items with the largest or smallest value of a numeric
+ * field. Items with equal values keep the order of the list, items whose
+ * value is NaN are skipped.
+ * @param list[in] - list to search
+ * @param field[in] - numeric field to rank by (not DATA_FIELD_NAME)
+ * @param k[in] - number of items wanted
+ * @param largest[in] - true for the top k, false for the bottom k
+ * @param out[out] - array of k pointers, or as many as the list has items
+ * if it is shorter, receives the items from the best one
+ * @return Returns the number of items stored in out, less than k if the
+ * list is shorter, 0 for an invalid argument or if the heap could not be
+ * allocated. The heap grows with the items found, up to k entries.
+ */
+size_t List_Top_K(List_t list, Data_Field_t field, size_t k, bool largest,
+                  const List_Node_t** out);
+
+/**
+ * @brief Same as List_Top_K, but the list is cut into chunks searched by
+ * worker threads, whose heaps are merged at the end. A singly linked list
+ * can only be cut without walking it when the order-statistic index is
+ * attached (List_Order_Attach); without it, and outside Linux, the search
+ * runs in the calling thread.
+ * @param workers[in] - number of threads, 0 for one per CPU
+ * @return Returns the same result as List_Top_K
+ */
+size_t List_Top_K_Parallel(List_t list, Data_Field_t field, size_t k,
+                           bool largest, int workers, const List_Node_t** out);
+
+#endif /* TOPK_H */
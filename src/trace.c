@@ -0,0 +1,283 @@
+/**
+ * @file       trace.c
+ * @date       10/2026
+ * @brief      Binary traces of list operations
+ * ****************************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ */
+
+#if !defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 200809L
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+/* Private includes -------------------------------------------------------- */
+#include "trace.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/stat.h>
+#else
+#include <stdio.h>
+#endif
+
+/* Private types and constants --------------------------------------------- */
+#define TRACE_MAGIC "LISTTRCE"
+#define TRACE_BOM 0x01020304u
+#define TRACE_BUFFER_SIZE (256u * 1024u)
+
+/* traces are binary, Windows would translate line breaks without it */
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t bom;
+} Trace_Header_t;
+
+static const char* const opNames[TRACE_OP_COUNT] = {
+    "Init",      "Actualize",    "Insert_First", "First",
+    "Copy_First", "Delete_First", "Post_Delete",  "Post_Insert",
+    "Copy",      "Succ",         "Is_Active",
+};
+
+/* Private functions ------------------------------------------------------- */
+
+static bool write_all(int fd, const void* data, size_t len) {
+    const char* p = data;
+    while(len) {
+        ssize_t n = write(fd, p, len);
+        if(n < 0) {
+            if(errno == EINTR)
+                continue;
+            return false;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+static void writer_flush(Trace_Writer_t* w) {
+    if(w->used && w->ok)
+        w->ok = write_all(w->fd, w->buffer, w->used);
+    w->used = 0;
+}
+
+/* Functions definitions --------------------------------------------------- */
+
+int Trace_Op_From_Char(char c) {
+    if(c >= '0' && c <= '9')
+        return TRACE_OP_INIT + (c - '0');
+    if(c == 'A' || c == 'a')
+        return TRACE_OP_IS_ACTIVE;
+    return -1;
+}
+
+const char* Trace_Op_Name(Trace_Op_t op) {
+    if((unsigned)op >= TRACE_OP_COUNT)
+        return "?";
+    return opNames[op];
+}
+
+bool Trace_Op_Has_Data(Trace_Op_t op) {
+    return op == TRACE_OP_ACTUALIZE || op == TRACE_OP_INSERT_FIRST ||
+           op == TRACE_OP_POST_INSERT;
+}
+
+bool Trace_Open(Trace_Writer_t* writer, const char* path) {
+    Trace_Header_t header;
+
+    if(!writer || !path)
+        return false;
+
+    memset(writer, 0, sizeof(*writer));
+    writer->buffer = malloc(TRACE_BUFFER_SIZE);
+    writer->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_BINARY, 0644);
+    if(!writer->buffer || writer->fd < 0) {
+        if(writer->fd >= 0)
+            close(writer->fd);
+        free(writer->buffer);
+        writer->buffer = NULL;
+        writer->fd = -1;
+        return false;
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_VERSION;
+    header.bom = TRACE_BOM;
+    memcpy(writer->buffer, &header, sizeof(header));
+    writer->used = sizeof(header);
+    writer->ok = true;
+    return true;
+}
+
+bool Trace_Record(Trace_Writer_t* writer, Trace_Op_t op, const Data_t* data) {
+    if(!writer || !writer->buffer || (unsigned)op >= TRACE_OP_COUNT)
+        return false;
+    if(Trace_Op_Has_Data(op) && !data)
+        return false;
+
+    if(TRACE_BUFFER_SIZE - writer->used < 1 + DATA_ENCODED_MAX)
+        writer_flush(writer);
+    writer->buffer[writer->used++] = (unsigned char)op;
+    if(Trace_Op_Has_Data(op))
+        writer->used += Data_Encode(data, writer->buffer + writer->used);
+    writer->count++;
+    return writer->ok;
+}
+
+bool Trace_Close(Trace_Writer_t* writer) {
+    bool ok;
+
+    if(!writer || !writer->buffer)
+        return false;
+
+    writer_flush(writer);
+    ok = writer->ok;
+    if(close(writer->fd) != 0)
+        ok = false;
+    free(writer->buffer);
+    writer->buffer = NULL;
+    writer->fd = -1;
+    return ok;
+}
+
+#ifdef __linux__
+
+bool Trace_Map(Trace_Reader_t* reader, const char* path) {
+    Trace_Header_t header;
+    struct stat st;
+    void* map;
+    int fd;
+
+    if(!reader || !path)
+        return false;
+    memset(reader, 0, sizeof(*reader));
+
+    fd = open(path, O_RDONLY);
+    if(fd < 0)
+        return false;
+    if(fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(header)) {
+        close(fd);
+        return false;
+    }
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(map == MAP_FAILED)
+        return false;
+
+    memcpy(&header, map, sizeof(header));
+    if(memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) != 0 ||
+       header.version != TRACE_VERSION || header.bom != TRACE_BOM) {
+        munmap(map, (size_t)st.st_size);
+        return false;
+    }
+
+    posix_madvise(map, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+    reader->map = map;
+    reader->size = (size_t)st.st_size;
+    reader->pos = sizeof(header);
+    return true;
+}
+
+#else /* !__linux__ */
+
+bool Trace_Map(Trace_Reader_t* reader, const char* path) {
+    Trace_Header_t header;
+    unsigned char* text;
+    FILE* file;
+    long size;
+    bool ok;
+
+    if(!reader || !path)
+        return false;
+    memset(reader, 0, sizeof(*reader));
+
+    /* no mmap, the file is read into memory as a whole */
+    file = fopen(path, "rb");
+    if(!file)
+        return false;
+    if(fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) < (long)sizeof(header) ||
+       fseek(file, 0, SEEK_SET) != 0) {
+        fclose(file);
+        return false;
+    }
+    text = malloc((size_t)size);
+    ok = text && fread(text, 1, (size_t)size, file) == (size_t)size;
+    fclose(file);
+    if(ok) {
+        memcpy(&header, text, sizeof(header));
+        ok = memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) == 0 &&
+             header.version == TRACE_VERSION && header.bom == TRACE_BOM;
+    }
+    if(!ok) {
+        free(text);
+        return false;
+    }
+
+    reader->map = text;
+    reader->size = (size_t)size;
+    reader->pos = sizeof(header);
+    return true;
+}
+
+#endif /* __linux__ */
+
+int Trace_Next(Trace_Reader_t* reader, Trace_Op_t* op, Data_t* data) {
+    unsigned code;
+
+    if(!reader || !reader->map || !op)
+        return -1;
+    if(reader->pos >= reader->size)
+        return 0;
+
+    code = reader->map[reader->pos];
+    if(code >= TRACE_OP_COUNT)
+        return -1;
+    *op = (Trace_Op_t)code;
+    if(Trace_Op_Has_Data(*op)) {
+        Data_t tmp;
+        size_t used = Data_Decode(reader->map + reader->pos + 1,
+                                  reader->size - reader->pos - 1,
+                                  data ? data : &tmp);
+        if(!used)
+            return -1;
+        reader->pos += used;
+    }
+    reader->pos++;
+    return 1;
+}
+
+#ifdef __linux__
+
+void Trace_Unmap(Trace_Reader_t* reader) {
+    if(!reader || !reader->map)
+        return;
+    munmap((void*)reader->map, reader->size);
+    reader->map = NULL;
+    reader->size = 0;
+    reader->pos = 0;
+}
+
+#else /* !__linux__ */
+
+void Trace_Unmap(Trace_Reader_t* reader) {
+    if(!reader || !reader->map)
+        return;
+    free((void*)reader->map);
+    reader->map = NULL;
+    reader->size = 0;
+    reader->pos = 0;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,135 @@
+/**
+ * @file       trace.h
+ * @date       10/2026
+ * @brief      Binary traces of list operations
+ * **********************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * Trace file layout (all numbers in the byte order of the host):
+ *
+ * | offset | size | content                                         |
+ * |--------|------|-------------------------------------------------|
+ * | 0      | 8    | magic "LISTTRCE"                                |
+ * | 8      | 4    | format version (#TRACE_VERSION)                 |
+ * | 12     | 4    | byte order mark 0x01020304                      |
+ * | 16     | ...  | operations                                      |
+ *
+ * Every operation is one byte with its Trace_Op_t code. Operations that
+ * carry a record (Actualize, Insert_First, Post_Insert) are followed by
+ * the record encoded by Data_Encode.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+/* Public includes --------------------------------------------------------- */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "data.h"
+
+/** Version of the trace format written by Trace_Open */
+#define TRACE_VERSION 1
+
+/** Operations of the list, codes match the commands of the menu in main.c */
+typedef enum {
+    TRACE_OP_INIT = 0,      /**< '0' List_Init */
+    TRACE_OP_ACTUALIZE,     /**< '1' List_Actualize, carries a record */
+    TRACE_OP_INSERT_FIRST,  /**< '2' List_Insert_First, carries a record */
+    TRACE_OP_FIRST,         /**< '3' List_First */
+    TRACE_OP_COPY_FIRST,    /**< '4' List_Copy_First */
+    TRACE_OP_DELETE_FIRST,  /**< '5' List_Delete_First */
+    TRACE_OP_POST_DELETE,   /**< '6' List_Post_Delete */
+    TRACE_OP_POST_INSERT,   /**< '7' List_Post_Insert, carries a record */
+    TRACE_OP_COPY,          /**< '8' List_Copy */
+    TRACE_OP_SUCC,          /**< '9' List_Succ */
+    TRACE_OP_IS_ACTIVE,     /**< 'A' List_Is_Active */
+    TRACE_OP_COUNT
+} Trace_Op_t;
+
+/** Buffered writer of a trace file */
+typedef struct {
+    int fd;                 /**< output descriptor */
+    unsigned char* buffer;  /**< pending bytes */
+    size_t used;            /**< number of pending bytes */
+    uint64_t count;         /**< number of recorded operations */
+    bool ok;                /**< false after the first write error */
+} Trace_Writer_t;
+
+/** Memory mapped trace file */
+typedef struct {
+    const unsigned char* map; /**< whole file */
+    size_t size;              /**< size of the file */
+    size_t pos;               /**< offset of the next operation */
+} Trace_Reader_t;
+
+/* Public trace API -------------------------------------------------------- */
+/**
+ * @brief Converts a command of the menu ('0'-'9', 'A' or 'a') to an operation
+ * @param c[in] - command character
+ * @return Returns the operation or -1 if the character is not an operation
+ */
+int Trace_Op_From_Char(char c);
+
+/**
+ * @brief Returns the name of the List_* function performing the operation
+ */
+const char* Trace_Op_Name(Trace_Op_t op);
+
+/**
+ * @brief Returns true if the operation is followed by a record
+ */
+bool Trace_Op_Has_Data(Trace_Op_t op);
+
+/**
+ * @brief Creates (truncates) a trace file and writes its header
+ * @param writer[out] - writer to initialize
+ * @param path[in] - path of the trace file
+ * @return Returns false if the file could not be created
+ */
+bool Trace_Open(Trace_Writer_t* writer, const char* path);
+
+/**
+ * @brief Appends one operation to the trace
+ * @param writer[in] - opened writer
+ * @param op[in] - recorded operation
+ * @param data[in] - record of the operation, ignored by operations without
+ * a record
+ * @return Returns false if the operation is invalid or writing failed
+ */
+bool Trace_Record(Trace_Writer_t* writer, Trace_Op_t op, const Data_t* data);
+
+/**
+ * @brief Flushes the pending operations and closes the file
+ * @return Returns false if any write since Trace_Open failed
+ */
+bool Trace_Close(Trace_Writer_t* writer);
+
+/**
+ * @brief Maps a trace file into memory and checks its header
+ *
+ * Outside Linux the file is read into memory instead.
+ * @param reader[out] - reader to initialize
+ * @param path[in] - path of the trace file
+ * @return Returns false if the file could not be read or it is not a trace
+ * of a supported version
+ */
+bool Trace_Map(Trace_Reader_t* reader, const char* path);
+
+/**
+ * @brief Reads the next operation of the trace
+ * @param reader[in] - mapped trace
+ * @param op[out] - operation
+ * @param data[out] - record of the operation, left untouched by operations
+ * without a record
+ * @return Returns 1 if an operation was read, 0 at the end of the trace and
+ * -1 if the trace is corrupted
+ */
+int Trace_Next(Trace_Reader_t* reader, Trace_Op_t* op, Data_t* data);
+
+/**
+ * @brief Unmaps the trace file
+ */
+void Trace_Unmap(Trace_Reader_t* reader);
+
+#endif /* TRACE_H */
@@ -0,0 +1,423 @@
+/**
+ * @file       perf_tests.c
+ * @date       10/2026
+ * @brief      Performance regression tests of ADT list against a stored
+ * baseline
+ * **********************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * Usage: perf_tests [-b baseline] [-t percent] [-n items] [-u]
+ *
+ * Every scenario runs REPEATS times on a list of -n items (default: the
+ * count of the baseline, else 200000), interleaved with a reference loop
+ * doing the same work on a bare malloc'ed singly linked list in this file.
+ * The median of the CPU time ratios list / reference of the adjacent runs,
+ * measured by mu_timer_cpu, carries over between machines and load far
+ * better than absolute times. A scenario fails when its ratio is more than
+ * -t percent (default 25, or LIST_PERF_THRESHOLD from the environment) over
+ * its value in the baseline file. Scenarios missing in the baseline only
+ * report their ratio. -u writes the measured ratios as the new baseline
+ * instead of comparing. A baseline recorded with another -n is refused, the
+ * ratios depend on how much of the list fits in the caches.
+ */
+
+/* Private includes -------------------------------------------------------- */
+#include <stdlib.h>
+#include <string.h>
+#include "../../src/list.h"
+#include "../minunit.h"
+
+#define DEFAULT_BASELINE "tests/perf/baseline.txt"
+#define DEFAULT_THRESHOLD 25.0
+#define DEFAULT_ITEMS 200000L
+#define REPEATS 9
+#define MAX_SCENARIOS 16
+
+typedef struct {
+  char name[32];
+  double ratio;
+} perf_entry_t;
+
+/** Item of the reference list, laid out like List_Node_t */
+typedef struct ref_node {
+  Data_t data;
+  struct ref_node *next;
+} ref_node_t;
+
+static const char *baselinePath = DEFAULT_BASELINE;
+static double threshold = DEFAULT_THRESHOLD;
+static long items = -1; /* -n not given */
+static bool update = false;
+
+static perf_entry_t baseline[MAX_SCENARIOS];
+static int baselineCount = 0;
+static long baselineItems = 0;
+static perf_entry_t measured[MAX_SCENARIOS];
+static int measuredCount = 0;
+
+static volatile double sink;
+
+static void load_baseline(void) {
+  FILE *f = fopen(baselinePath, "r");
+  char line[128];
+
+  if (f == NULL) {
+    return;
+  }
+  while (fgets(line, sizeof(line), f) != NULL && baselineCount < MAX_SCENARIOS) {
+    perf_entry_t *e = &baseline[baselineCount];
+    if (line[0] == '#' || sscanf(line, "items %ld", &baselineItems) == 1) {
+      continue;
+    }
+    if (sscanf(line, "%31s %lf", e->name, &e->ratio) == 2 && e->ratio > 0) {
+      baselineCount++;
+    }
+  }
+  fclose(f);
+}
+
+static bool save_baseline(void) {
+  FILE *f = fopen(baselinePath, "w");
+
+  if (f == NULL) {
+    return false;
+  }
+  fprintf(f, "# list / reference time ratios of tests/perf/perf_tests.c, "
+             "regenerate with perf_tests -u\n");
+  fprintf(f, "items %ld\n", items);
+  for (int i = 0; i < measuredCount; i++) {
+    fprintf(f, "%s %.3f\n", measured[i].name, measured[i].ratio);
+  }
+  return fclose(f) == 0;
+}
+
+static const perf_entry_t *find_baseline(const char *name) {
+  for (int i = 0; i < baselineCount; i++) {
+    if (strcmp(baseline[i].name, name) == 0) {
+      return &baseline[i];
+    }
+  }
+  return NULL;
+}
+
+static void make_data(Data_t *data) {
+  strcpy(data->name, "Perf");
+  data->age = 30;
+  data->weight = 70;
+  data->height = 180;
+}
+
+static void build(List_t *list, long count) {
+  Data_t data;
+  make_data(&data);
+  List_Init(list);
+  for (long i = 0; i < count; i++) {
+    List_Insert_First(list, data);
+  }
+}
+
+static void teardown(List_t *list) {
+  while (list->first != NULL) {
+    List_Delete_First(list);
+  }
+}
+
+/* Scenarios: each one times only its own loop and leaves the list empty */
+
+static double scenario_insert_first(void) {
+  List_t list;
+  Data_t data;
+  double start, elapsed;
+  make_data(&data);
+  List_Init(&list);
+  start = mu_timer_cpu();
+  for (long i = 0; i < items; i++) {
+    List_Insert_First(&list, data);
+  }
+  elapsed = mu_timer_cpu() - start;
+  teardown(&list);
+  return elapsed;
+}
+
+static double scenario_post_insert(void) {
+  List_t list;
+  Data_t data;
+  double start, elapsed;
+  make_data(&data);
+  build(&list, 1);
+  List_First(&list);
+  start = mu_timer_cpu();
+  for (long i = 1; i < items; i++) {
+    List_Post_Insert(&list, data);
+    List_Succ(&list);
+  }
+  elapsed = mu_timer_cpu() - start;
+  teardown(&list);
+  return elapsed;
+}
+
+static double scenario_traverse(void) {
+  List_t list;
+  Data_t data;
+  double start, elapsed, sum = 0;
+  build(&list, items);
+  start = mu_timer_cpu();
+  List_First(&list);
+  while (List_Copy(list, &data)) {
+    sum += data.age;
+    List_Succ(&list);
+  }
+  elapsed = mu_timer_cpu() - start;
+  sink = sum;
+  teardown(&list);
+  return elapsed;
+}
+
+static double scenario_post_delete(void) {
+  List_t list;
+  double start, elapsed;
+  build(&list, items);
+  List_First(&list);
+  start = mu_timer_cpu();
+  for (long i = 1; i < items; i++) {
+    List_Post_Delete(&list);
+  }
+  elapsed = mu_timer_cpu() - start;
+  teardown(&list);
+  return elapsed;
+}
+
+static double scenario_teardown(void) {
+  List_t list;
+  double start;
+  build(&list, items);
+  start = mu_timer_cpu();
+  teardown(&list);
+  return mu_timer_cpu() - start;
+}
+
+/* Reference scenarios: the same loops on a bare list, without the checks,
+   statistics and attachments of List_t */
+
+static ref_node_t *ref_insert(ref_node_t **link, const Data_t *data) {
+  ref_node_t *node = malloc(sizeof(*node));
+  if (node != NULL) {
+    node->data = *data;
+    node->next = *link;
+    *link = node;
+  }
+  return node;
+}
+
+static ref_node_t *ref_build(long count) {
+  ref_node_t *first = NULL;
+  Data_t data;
+  make_data(&data);
+  for (long i = 0; i < count; i++) {
+    ref_insert(&first, &data);
+  }
+  return first;
+}
+
+static void ref_teardown(ref_node_t **first) {
+  while (*first != NULL) {
+    ref_node_t *node = *first;
+    *first = node->next;
+    free(node);
+  }
+}
+
+static double reference_insert_first(void) {
+  ref_node_t *first = NULL;
+  Data_t data;
+  double start, elapsed;
+  make_data(&data);
+  start = mu_timer_cpu();
+  for (long i = 0; i < items; i++) {
+    ref_insert(&first, &data);
+  }
+  elapsed = mu_timer_cpu() - start;
+  ref_teardown(&first);
+  return elapsed;
+}
+
+static double reference_post_insert(void) {
+  ref_node_t *first = ref_build(1);
+  ref_node_t *active = first;
+  Data_t data;
+  double start, elapsed;
+  make_data(&data);
+  start = mu_timer_cpu();
+  for (long i = 1; i < items && active != NULL; i++) {
+    ref_insert(&active->next, &data);
+    active = active->next;
+  }
+  elapsed = mu_timer_cpu() - start;
+  ref_teardown(&first);
+  return elapsed;
+}
+
+static double reference_traverse(void) {
+  ref_node_t *first = ref_build(items);
+  Data_t data;
+  double start, elapsed, sum = 0;
+  start = mu_timer_cpu();
+  for (ref_node_t *node = first; node != NULL; node = node->next) {
+    data = node->data;
+    sum += data.age;
+  }
+  elapsed = mu_timer_cpu() - start;
+  sink = sum;
+  ref_teardown(&first);
+  return elapsed;
+}
+
+static double reference_post_delete(void) {
+  ref_node_t *first = ref_build(items);
+  double start, elapsed;
+  start = mu_timer_cpu();
+  for (long i = 1; i < items && first->next != NULL; i++) {
+    ref_node_t *node = first->next;
+    first->next = node->next;
+    free(node);
+  }
+  elapsed = mu_timer_cpu() - start;
+  ref_teardown(&first);
+  return elapsed;
+}
+
+static double reference_teardown(void) {
+  ref_node_t *first = ref_build(items);
+  double start;
+  start = mu_timer_cpu();
+  ref_teardown(&first);
+  return mu_timer_cpu() - start;
+}
+
+/**
+ * Runs a scenario interleaved with its reference, records the median ratio
+ * of the adjacent runs and compares it with the baseline. Returns false and
+ * fills message on a regression.
+ */
+static bool check_scenario(const char *name, double (*scenario)(void),
+                           double (*reference)(void), char *message,
+                           size_t size) {
+  const perf_entry_t *base = find_baseline(name);
+  double best = -1, bestReference = -1;
+  double ratios[REPEATS];
+  double ratio;
+
+  for (int i = 0; i < REPEATS; i++) {
+    double t = scenario();
+    double r = reference();
+    int j = i;
+    if (best < 0 || t < best) {
+      best = t;
+    }
+    if (bestReference < 0 || r < bestReference) {
+      bestReference = r;
+    }
+    /* both runs of a pair see the same machine, keep the ratios sorted */
+    ratio = r > 0 ? t / r : 0;
+    for (; j > 0 && ratios[j - 1] > ratio; j--) {
+      ratios[j] = ratios[j - 1];
+    }
+    ratios[j] = ratio;
+  }
+  ratio = ratios[REPEATS / 2];
+  if (measuredCount < MAX_SCENARIOS) {
+    strcpy(measured[measuredCount].name, name);
+    measured[measuredCount++].ratio = ratio;
+  }
+
+  printf("\n  %-14s %9.2f ns/op  reference %9.2f ns/op  ratio %6.3f", name,
+         best * 1e9 / items, bestReference * 1e9 / items, ratio);
+  if (base == NULL || update) {
+    return true;
+  }
+  printf("  baseline %6.3f  %+6.1f %%", base->ratio,
+         (ratio / base->ratio - 1) * 100);
+  if (ratio > base->ratio * (1 + threshold / 100)) {
+    snprintf(message, size, "%s: ratio %.3f is more than %.0f %% over the "
+             "baseline %.3f", name, ratio, threshold, base->ratio);
+    return false;
+  }
+  return true;
+}
+
+#define PERF_TEST(name)                                                        \
+  MU_TEST(test_perf_##name) {                                                  \
+    char message[256];                                                         \
+    bool ok = check_scenario(#name, scenario_##name, reference_##name,         \
+                             message, sizeof(message));                        \
+    mu_assert(ok, message);                                                    \
+  }
+
+PERF_TEST(insert_first)
+PERF_TEST(post_insert)
+PERF_TEST(traverse)
+PERF_TEST(post_delete)
+PERF_TEST(teardown)
+
+MU_TEST_SUITE(perf_suite) {
+  MU_RUN_TEST(test_perf_insert_first);
+  MU_RUN_TEST(test_perf_post_insert);
+  MU_RUN_TEST(test_perf_traverse);
+  MU_RUN_TEST(test_perf_post_delete);
+  MU_RUN_TEST(test_perf_teardown);
+}
+
+int main(int argc, char **argv) {
+  const char *env = getenv("LIST_PERF_THRESHOLD");
+
+  if (env != NULL) {
+    threshold = atof(env);
+  }
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+      baselinePath = argv[++i];
+    } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+      threshold = atof(argv[++i]);
+    } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      items = atol(argv[++i]);
+    } else if (strcmp(argv[i], "-u") == 0) {
+      update = true;
+    } else {
+      printf("Usage: %s [-b baseline] [-t percent] [-n items] [-u]\n", argv[0]);
+      return 1;
+    }
+  }
+  if ((items != -1 && items < 2) || threshold <= 0) {
+    printf("Invalid number of items or threshold\n");
+    return 1;
+  }
+
+  load_baseline();
+  if (!update && baselineCount > 0) {
+    if (baselineItems == 0) {
+      printf("Baseline %s has no item count, regenerate it with -u\n",
+             baselinePath);
+      return 1;
+    }
+    if (items != -1 && items != baselineItems) {
+      printf("Baseline %s was recorded with %ld items, not %ld\n",
+             baselinePath, baselineItems, items);
+      return 1;
+    }
+    items = baselineItems;
+  }
+  if (items == -1) {
+    items = DEFAULT_ITEMS;
+  }
+  printf("%ld items, %d repeats, threshold %.0f %%, baseline %s%s", items,
+         REPEATS, threshold, baselinePath,
+         update ? " (updating)" : baselineCount ? "" : " (missing)");
+  MU_RUN_SUITE(perf_suite);
+  MU_REPORT();
+
+  if (update && !save_baseline()) {
+    printf("Can't write %s\n", baselinePath);
+    return 1;
+  }
+  return minunit_fail ? 1 : 0;
+}
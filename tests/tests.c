@@ -10,8 +10,29 @@
 /* Private includes -------------------------------------------------------- */
 #include <inttypes.h>
 #include <string.h>
+#include "../src/aggregate.h"
+#include "../src/arena.h"
+#include "../src/bloom.h"
+#include "../src/csvio.h"
+#include "../src/ilist.h"
+#include "../src/ioutils.h"
 #include "../src/list.h"
+#include "../src/loader.h"
+#include "../src/order.h"
+#include "../src/plist.h"
+#include "../src/query.h"
+#include "../src/server.h"
+#include "../src/sketch.h"
+#include "../src/snapshot.h"
+#include "../src/topk.h"
+#include "../src/trace.h"
 #include "minunit.h"
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
 
 ////////////////////////////// IMPORTANT ///////////////////////////////////////
 /////////// Source repository: https://github.com/siu/minunit //////////////////
@@ -274,6 +295,1171 @@ MU_TEST(test_is_active) {
   free(listArray);
 }
 
+MU_TEST(test_parse_double) {
+  const char *text = " -12.5\n3";
+  const char *next;
+  double value;
+  mu_assert(io_utils_parse_double(text, text + strlen(text), &value, &next),
+            "Number should be parsed.");
+  mu_assert_double_eq(-12.5, value);
+  mu_assert(*next == '\n', "Parsing should stop at the end of line.");
+  mu_assert(!io_utils_parse_double(next, text + strlen(text), &value, NULL),
+            "Empty line is not a number.");
+
+  /* longer than any stack copy: 0.000...001 with 80 zeros after the point */
+  char zeros[100] = "0.";
+  memset(zeros + 2, '0', 80);
+  strcpy(zeros + 82, "1 2");
+  mu_assert(io_utils_parse_double(zeros, zeros + strlen(zeros), &value, &next),
+            "Long number should be parsed.");
+  mu_assert(value == 1e-81, "Long number was truncated.");
+  mu_assert(next == zeros + 83, "Parsing should stop after the long number.");
+}
+
+MU_TEST(test_data_format) {
+  /* ties and values just below them, negative zero and huge values */
+  const double values[] = {0.25, 0.35, 0.05, -0.04, -0.0, 2.5, 1e300, 123.45};
+  char expected[DATA_FORMAT_MAX];
+  char line[DATA_FORMAT_MAX];
+
+  for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+    Data_t data = {.age = values[i], .weight = -values[i],
+                   .height = values[i] * 3, .name = "Anna"};
+    size_t len = Data_Format(&data, line);
+    line[len] = 0;
+    sprintf(expected, "Name=%s, age=%0.1lf, weight=%0.1lf, height=%0.1lf\n",
+            data.name, data.age, data.weight, data.height);
+    mu_assert(strcmp(expected, line) == 0,
+              "Data_Format differs from printf.");
+  }
+}
+
+MU_TEST(test_list_dump) {
+  const char *path = "test_dump.txt";
+  Data_t dataList = {.age = 23, .weight = 70, .height = 150, .name = "John"};
+  FILE *f = fopen(path, "w+");
+  char line[128];
+  List_t list;
+  int lines = 0;
+  List_Init(&list);
+
+  for (int i = 0; i < 2000; i++) {
+    List_Insert_First(&list, dataList);
+  }
+
+  mu_assert(List_Dump(list, fileno(f)), "List_Dump failed.");
+  rewind(f);
+
+  while (fgets(line, sizeof(line), f) != NULL) {
+    mu_assert_string_eq("Name=John, age=23.0, weight=70.0, height=150.0\n",
+                        line);
+    lines++;
+  }
+
+  mu_assert_int_eq(2000, lines);
+  fclose(f);
+  remove(path);
+
+  while (list.first != NULL) {
+    List_Delete_First(&list);
+  }
+}
+
+MU_TEST(test_reader_lines) {
+  const char *path = "test_reader.txt";
+  FILE *f = fopen(path, "w+");
+  io_reader_t reader;
+  io_line_t line;
+  char name[8];
+  long count;
+  double value;
+  fputs("Catherine Zeta\r\n42\nx\n-1.5\n\nlast", f);
+  rewind(f);
+  /* tiny buffer, the first line has to grow it */
+  mu_assert(io_reader_open_file(&reader, f, 4), "Opening reader failed.");
+  mu_assert(io_reader_get_string(&reader, name, sizeof(name)),
+            "Reading string failed.");
+  mu_assert_string_eq("Catheri", name);
+  mu_assert(io_reader_get_long(&reader, &count), "Reading long failed.");
+  mu_assert_int_eq(42, (int)count);
+  mu_assert(io_reader_get_double(&reader, &value), "Reading double failed.");
+  mu_assert_double_eq(-1.5, value);
+  mu_assert(io_reader_next_line(&reader, &line), "Empty line is a line.");
+  mu_assert_int_eq(0, (int)line.len);
+  mu_assert(io_reader_next_line(&reader, &line), "Missing last line.");
+  mu_assert_int_eq(4, (int)line.len);
+  mu_assert(0 == memcmp(line.ptr, "last", 4), "Wrong last line.");
+  mu_assert(!io_reader_next_line(&reader, &line), "Input should be over.");
+  io_reader_close(&reader);
+  fclose(f);
+  remove(path);
+}
+
+MU_TEST(test_load_buffer) {
+  const char *text = "John\n23\n70.5\n150\r\nCatherine\n35\n78\n176\n";
+  List_t list;
+  size_t count;
+  List_Init(&list);
+  mu_assert(List_Load_Buffer(&list, text, strlen(text), &count),
+            "Loading valid records failed.");
+  mu_assert_int_eq(2, (int)count);
+  mu_assert_string_eq("John", list.first->data.name);
+  mu_assert_double_eq(70.5, list.first->data.weight);
+  mu_assert_string_eq("Catherine", list.first->next->data.name);
+  mu_assert_double_eq(176, list.first->next->data.height);
+  mu_assert(list.active == NULL, "Loading should not change the active item.");
+  text = "Anna\n19\nx\n";
+  mu_assert(!List_Load_Buffer(&list, text, strlen(text), &count),
+            "Malformed record should be reported.");
+  mu_assert_int_eq(0, (int)count);
+
+  while (list.first != NULL) {
+    List_Delete_First(&list);
+  }
+}
+
+MU_TEST(test_load_text_parallel) {
+  const char *path = "test_records.txt";
+  FILE *f = fopen(path, "w");
+  List_t list;
+  size_t count;
+  int i = 0;
+
+  for (i = 0; i < 50000; i++) {
+    fprintf(f, "Name %d\n%d\n%d.5\n180\n", i, i % 90, i % 120);
+  }
+
+  fclose(f);
+  List_Init(&list);
+  mu_assert(List_Load_Text_Parallel(&list, path, 2, &count),
+            "Parallel loading failed.");
+  mu_assert_int_eq(50000, (int)count);
+  i = 0;
+
+  for (List_Node_t *node = list.first; node != NULL; node = node->next, i++) {
+    char name[32];
+    sprintf(name, "Name %d", i);
+
+    if (strcmp(name, node->data.name) != 0 ||
+        node->data.weight != i % 120 + 0.5) {
+      break;
+    }
+  }
+
+  mu_assert_int_eq(50000, i);
+
+  /* 4 MiB without a line break: rejected without buffering it all */
+  f = fopen(path, "w");
+  for (i = 0; i < 4 * 1024 * 1024; i++) {
+    fputc('x', f);
+  }
+  fclose(f);
+  mu_assert(!List_Load_Text_Parallel(&list, path, 2, &count),
+            "A file without line breaks should be rejected.");
+  remove(path);
+
+  while (list.first != NULL) {
+    List_Delete_First(&list);
+  }
+}
+
+#ifdef __linux__
+MU_TEST(test_snapshot_save_load) {
+  const char *path = "test_snapshot.bin";
+  Data_t john = {.age = 23, .weight = 70, .height = 150, .name = "John"};
+  Data_t anna = {.age = 19, .weight = 56, .height = 158, .name = "Anna"};
+  List_t list, loaded;
+  size_t count;
+  List_Init(&list);
+  List_Init(&loaded);
+  List_Insert_First(&list, john);
+  List_Insert_First(&list, anna);
+  List_First(&list);
+  List_Succ(&list);
+  mu_assert(List_Save(&list, path), "Saving snapshot failed.");
+  mu_assert(List_Load(&loaded, path, &count), "Loading snapshot failed.");
+  mu_assert_int_eq(2, (int)count);
+  mu_assert_string_eq("Anna", loaded.first->data.name);
+  mu_assert_double_eq(158, loaded.first->data.height);
+  mu_assert_string_eq("John", loaded.first->next->data.name);
+  mu_assert(loaded.active == loaded.first->next,
+            "Saved active item should be restored.");
+
+  {
+    /* flip one payload byte, the checksum has to catch it */
+    FILE *f = fopen(path, "r+b");
+    int c;
+    fseek(f, -3, SEEK_END);
+    c = fgetc(f);
+    fseek(f, -3, SEEK_END);
+    fputc(c ^ 0x40, f);
+    fclose(f);
+  }
+  mu_assert(!List_Load(&loaded, path, &count),
+            "Corrupted snapshot should be rejected.");
+  mu_assert_int_eq(0, (int)count);
+
+  /* the record count (offset 16) and the active record (offset 24) are
+     covered by the checksum too, nothing is loaded from a bad header */
+  for (long offset = 16; offset <= 24; offset += 8) {
+    FILE *f;
+    mu_assert(List_Save(&list, path), "Saving snapshot failed.");
+    f = fopen(path, "r+b");
+    fseek(f, offset, SEEK_SET);
+    fputc(0, f);
+    fclose(f);
+    mu_assert(!List_Load(&loaded, path, &count),
+              "Corrupted header should be rejected.");
+    mu_assert_int_eq(0, (int)count);
+    mu_assert_int_eq(2, (int)List_Length(loaded));
+  }
+  remove(path);
+
+  while (list.first != NULL) {
+    List_Delete_First(&list);
+  }
+  while (loaded.first != NULL) {
+    List_Delete_First(&loaded);
+  }
+}
+#endif
+
+MU_TEST(test_csv_export_import) {
+  const char *path = "test_export.csv";
+  Data_t quoted = {.age = 0.1, .weight = 70, .height = 150,
+                   .name = "Smith, \"Jr\""};
+  Data_t plain = {.age = 19, .weight = 56.5, .height = 158, .name = "Anna"};
+  char buffer[CSV_RECORD_MAX];
+  char small[48];
+  List_t list, imported;
+  size_t count;
+  FILE *f = fopen(path, "w+");
+  List_Init(&list);
+  List_Init(&imported);
+  List_Insert_First(&list, plain);
+  List_Insert_First(&list, quoted);
+  mu_assert(List_Export_Csv(&list, fileno(f), buffer, sizeof(buffer), ',',
+                            true),
+            "Export failed.");
+  rewind(f);
+  mu_assert(fgets(buffer, sizeof(buffer), f) != NULL, "Missing header.");
+  mu_assert(fgets(buffer, sizeof(buffer), f) != NULL, "Missing record.");
+  mu_assert_string_eq("\"Smith, \"\"Jr\"\"\",0.1,70,150\n", buffer);
+  /* stdio may have the file buffered, the import reads the descriptor */
+  fclose(f);
+  f = fopen(path, "r");
+  /* the buffer holds only about one record, it has to be refilled */
+  mu_assert(List_Import_Csv(&imported, fileno(f), small, sizeof(small), ',',
+                            true, &count),
+            "Import failed.");
+  mu_assert_int_eq(2, (int)count);
+  mu_assert_string_eq(quoted.name, imported.first->data.name);
+  mu_assert_double_eq(0.1, imported.first->data.age);
+  mu_assert_string_eq("Anna", imported.first->next->data.name);
+  mu_assert_double_eq(56.5, imported.first->next->data.weight);
+  fclose(f);
+  remove(path);
+
+  while (list.first != NULL) {
+    List_Delete_First(&list);
+  }
+  while (imported.first != NULL) {
+    List_Delete_First(&imported);
+  }
+}
+
+MU_TEST(test_trace_record_replay) {
+  const char *path = "test_trace.bin";
+  Data_t john = {.age = 23, .weight = 70, .height = 150, .name = "John"};
+  Data_t data;
+  Trace_Writer_t writer;
+  Trace_Reader_t reader;
+  Trace_Op_t op;
+  mu_assert_int_eq(TRACE_OP_INSERT_FIRST, Trace_Op_From_Char('2'));
+  mu_assert_int_eq(TRACE_OP_IS_ACTIVE, Trace_Op_From_Char('a'));
+  mu_assert_int_eq(-1, Trace_Op_From_Char('M'));
+
+  mu_assert(Trace_Open(&writer, path), "Creating trace failed.");
+  mu_assert(Trace_Record(&writer, TRACE_OP_INSERT_FIRST, &john), "Recording failed.");
+  mu_assert(Trace_Record(&writer, TRACE_OP_FIRST, NULL), "Recording failed.");
+  mu_assert(!Trace_Record(&writer, TRACE_OP_POST_INSERT, NULL),
+            "Operation without its record should be rejected.");
+  mu_assert(Trace_Record(&writer, TRACE_OP_IS_ACTIVE, NULL), "Recording failed.");
+  mu_assert(Trace_Close(&writer), "Closing trace failed.");
+
+  mu_assert(Trace_Map(&reader, path), "Mapping trace failed.");
+  mu_assert_int_eq(1, Trace_Next(&reader, &op, &data));
+  mu_assert_int_eq(TRACE_OP_INSERT_FIRST, op);
+  mu_assert_string_eq("John", data.name);
+  mu_assert_double_eq(150, data.height);
+  mu_assert_int_eq(1, Trace_Next(&reader, &op, &data));
+  mu_assert_int_eq(TRACE_OP_FIRST, op);
+  mu_assert_int_eq(1, Trace_Next(&reader, &op, &data));
+  mu_assert_int_eq(TRACE_OP_IS_ACTIVE, op);
+  mu_assert_int_eq(0, Trace_Next(&reader, &op, &data));
+  Trace_Unmap(&reader);
+
+  mu_assert(!Trace_Map(&reader, "test_trace_missing.bin"),
+            "Missing trace should be rejected.");
+  remove(path);
+}
+
+MU_TEST(test_list_stats) {
+  Data_t john = {.age = 23, .weight = 70, .height = 150, .name = "John"};
+  List_Stats_t storage, stats;
+  List_t list;
+  List_Init(&list);
+#ifdef LIST_STATS
+  mu_assert(List_Stats_Attach(&list, &storage), "Attaching stats failed.");
+  List_Insert_First(&list, john);
+  List_Insert_First(&list, john);
+  List_Post_Delete(&list); /* no active item */
+  List_First(&list);
+  while (List_Is_Active(list)) {
+    List_Succ(&list);
+  }
+  List_First(&list);
+  List_Succ(&list);
+  mu_assert(List_Get_Stats(list, &stats), "Reading stats failed.");
+  mu_assert_int_eq(2, (int)stats.insertFirst);
+  mu_assert_int_eq(1, (int)stats.postDelete);
+  mu_assert_int_eq(1, (int)stats.postDeleteMiss);
+  mu_assert_int_eq(2, (int)stats.first);
+  mu_assert_int_eq(3, (int)stats.succ);
+  mu_assert_int_eq(3, (int)stats.isActive);
+  mu_assert_int_eq(1, (int)stats.traversals);
+  mu_assert_int_eq(2, (int)stats.traversalSteps);
+  mu_assert_int_eq(2, (int)stats.longestTraversal);
+  mu_assert_int_eq(1, (int)stats.currentTraversal);
+#else
+  mu_assert(!List_Stats_Attach(&list, &storage),
+            "Stats should not be available without LIST_STATS.");
+  List_Insert_First(&list, john);
+  mu_assert(!List_Get_Stats(list, &stats), "Stats should not be available.");
+  mu_assert_int_eq(0, (int)stats.insertFirst);
+#endif
+  while (list.first != NULL) {
+    List_Delete_First(&list);
+  }
+}
+
+static bool query_test_collect(const Data_t *data, void *context) {
+  char *names = context;
+  strcat(names, data->name);
+  strcat(names, ";");
+  return true;
+}
+
+MU_TEST(test_query_compile_match) {
+  Data_t john = {.age = 40, .weight = 80, .height = 180, .name = "John"};
+  Data_t jana = {.age = 20, .weight = 50, .height = 160, .name = "Jana"};
+  Data_t petr = {.age = 50, .weight = 90, .height = 190, .name = "Petr"};
+  char error[128];
+  char names[64] = "";
+  Query_t *query;
+  List_t list;
+  List_Init(&list);
+  List_Insert_First(&list, john);
+  List_Insert_First(&list, jana);
+  List_Insert_First(&list, petr);
+
+  query = Query_Compile("name ^= J and age > 30", error, sizeof(error));
+  mu_assert(query != NULL, error);
+  mu_assert(Query_Match(query, &john), "John should match.");
+  mu_assert(!Query_Match(query, &jana), "Jana is too young.");
+  mu_assert(!Query_Match(query, &petr), "Petr does not start with J.");
+  Query_Free(query);
+
+  query = Query_Compile("NOT (name = 'Petr') && !(height < 170) || weight >= 90",
+                        error, sizeof(error));
+  mu_assert(query != NULL, error);
+  mu_assert_int_eq(2, (int)List_Query(list, query, query_test_collect, names));
+  mu_assert_string_eq("Petr;John;", names);
+  Query_Free(query);
+
+  query = Query_Compile("name $= na or name *= oh", error, sizeof(error));
+  mu_assert(query != NULL, error);
+  mu_assert_int_eq(2, (int)List_Query(list, query, NULL, NULL));
+  mu_assert(list.active == NULL, "Query should not change the active item.");
+  Query_Free(query);
+
+  mu_assert(Query_Compile("age ^= 3", error, sizeof(error)) == NULL,
+            "Prefix of a number should be rejected.");
+  mu_assert(Query_Compile("size > 3", error, sizeof(error)) == NULL,
+            "Unknown field should be rejected.");
+  mu_assert(Query_Compile("age > 3 and", error, sizeof(error)) == NULL,
+            "Incomplete query should be rejected.");
+  mu_assert(Query_Compile("(age > 3", error, sizeof(error)) == NULL,
+            "Missing ) should be rejected.");
+  mu_assert_string_eq("column 9: expected )", error);
+
+  while (list.first != NULL) {
+    List_Delete_First(&list);
+  }
+}
+
+MU_TEST(test_list_order) {
+  Data_t data = {.age = 0, .weight = 0, .height = 0, .name = "Order"};
+  List_Node_t *last = NULL;
+  List_t list, plain;
+  size_t position, expected;
+  uint32_t random = 7;
+  List_Init(&list);
+
+  mu_assert(!List_Seek(&list, 0), "Seek in an empty list should fail.");
+  for (int i = 0; i < 500; i++) {
+    data.age = i;
+    last = List_Insert_After(&list, last, data);
+  }
+  mu_assert(List_Seek(&list, 42), "Seek without an index failed.");
+  mu_assert_double_eq(42, list.active->data.age);
+  mu_assert(List_Order_Attach(&list), "Attaching the index failed.");
+  mu_assert_int_eq(500, (int)List_Length(list));
+  mu_assert(List_Position(list, &position), "Position failed.");
+  mu_assert_int_eq(42, (int)position);
+  mu_assert(!List_Seek(&list, 500), "Seek past the end should fail.");
+  mu_assert(list.active->data.age == 42, "Failed seek moved the active item.");
+
+  /* random edits, checked against walking the list without the index */
+  for (int i = 0; i < 4000; i++) {
+    random = random * 1103515245u + 12345u;
+    List_Seek(&list, (random >> 8) % List_Length(list));
+    switch ((random >> 4) % 4) {
+    case 0:
+      List_Insert_First(&list, data);
+      break;
+    case 1:
+      List_Post_Insert(&list, data);
+      break;
+    case 2:
+      List_Post_Delete(&list);
+      break;
+    default:
+      List_Delete_First(&list);
+      break;
+    }
+    if (list.first == NULL) {
+      List_Insert_First(&list, data);
+    }
+    plain = list;
+    plain.ext = NULL; /* without the index the list is walked */
+    mu_assert_int_eq((int)List_Length(plain), (int)List_Length(list));
+    if (List_Is_Active(list)) {
+      mu_assert(List_Position(list, &position), "Position failed.");
+      mu_assert(List_Position(plain, &expected), "Walking position failed.");
+      mu_assert_int_eq((int)expected, (int)position);
+    }
+    position = (random >> 12) % List_Length(list);
+    mu_assert(List_Seek(&list, position), "Seek failed.");
+    List_Seek(&plain, position);
+    mu_assert(plain.active == list.active, "Seek found a different item.");
+  }
+
+  List_Order_Detach(&list);
+  mu_assert(!List_Order_Attached(list), "Detach should clear the index.");
+  mu_assert(list.ext == NULL, "Detach should free the attachments.");
+  while (list.first != NULL) {
+    List_Delete_First(&list);
+  }
+}
+
+MU_TEST(test_list_bloom) {
+  Data_t data = {.age = 0, .weight = 0, .height = 0, .name = "Bloom"};
+  Query_t *query;
+  List_t list;
+  int misses = 0;
+  List_Init(&list);
+
+  mu_assert(List_Maybe_Contains_Name(list, "Nobody"),
+            "Without a filter every name may be present.");
+  for (int i = 0; i < 1000; i++) {
+    snprintf(data.name, sizeof(data.name), "Person %d", i);
+    List_Insert_First(&list, data);
+  }
+  mu_assert(!List_Bloom_Attach(&list, 1000, 0), "Rate 0 should be rejected.");
+  mu_assert(List_Bloom_Attach(&list, 1000, 0.01), "Attaching the filter failed.");
+  mu_assert(!List_Bloom_Attach(&list, 1000, 0.01), "Second filter attached.");
+  for (int i = 0; i < 1000; i++) {
+    snprintf(data.name, sizeof(data.name), "Person %d", i);
+    mu_assert(List_Maybe_Contains_Name(list, data.name), "False negative.");
+  }
+  for (int i = 1000; i < 11000; i++) {
+    snprintf(data.name, sizeof(data.name), "Person %d", i);
+    misses += !List_Maybe_Contains_Name(list, data.name);
+  }
+  mu_assert(misses > 9700, "False positive rate is over 3 %.");
+
+  /* Person 999 is first, Person 998 second */
+  List_First(&list);
+  strcpy(data.name, "Renamed");
+  List_Actualize(&list, data);
+  mu_assert(List_Maybe_Contains_Name(list, "Renamed"), "Actualize not added.");
+  mu_assert(!List_Maybe_Contains_Name(list, "Person 999"),
+            "Actualize did not remove the old name.");
+  List_Post_Delete(&list);
+  mu_assert(!List_Maybe_Contains_Name(list, "Person 998"),
+            "Post_Delete did not remove the name.");
+  List_Delete_First(&list);
+  mu_assert(!List_Maybe_Contains_Name(list, "Renamed"),
+            "Delete_First did not remove the name.");
+
+  query = Query_Compile("name = 'Person 999'", NULL, 0);
+  mu_assert(query != NULL, "Query did not compile.");
+  mu_assert_int_eq(0, (int)List_Query(list, query, NULL, NULL));
+  Query_Free(query);
+
+  List_Bloom_Detach(&list);
+  mu_assert(list.ext == NULL, "Detach should clear the filter.");
+  while (list.first != NULL) {
+    List_Delete_First(&list);
+  }
+}
+
+static bool remove_test_odd_age(const Data_t *data, void *context) {
+  (*(int *)context)++;
+  return (int)data->age % 2 == 1;
+}
+
+MU_TEST(test_list_remove_if) {
+  Data_t data = {.age = 0, .weight = 0, .height = 0, .name = "Remove"};
+  List_Node_t *last = NULL;
+  Query_t *query;
+  size_t position;
+  int calls = 0;
+  List_t list;
+  List_Init(&list);
+
+  mu_assert_int_eq(0, (int)List_Remove_If(&list, remove_test_odd_age, &calls));
+  for (int i = 0; i < 10; i++) {
+    data.age = i;
+    last = List_Insert_After(&list, last, data);
+  }
+  mu_assert(List_Order_Attach(&list), "Attaching the index failed.");
+  List_Seek(&list, 4);
+  mu_assert_int_eq(5, (int)List_Remove_If(&list, remove_test_odd_age, &calls));
+  mu_assert_int_eq(10, calls);
+  mu_assert(list.active != NULL, "Kept active item was lost.");
+  mu_assert(List_Position(list, &position), "Position failed.");
+  mu_assert_int_eq(2, (int)position);
+  mu_assert_int_eq(5, (int)List_Length(list));
+  for (List_Node_t *node = list.first; node != NULL; node = node->next) {
+    mu_assert((int)node->data.age % 2 == 0, "Odd item was not removed.");
+  }
+
+  query = Query_Compile("age >= 4", NULL, 0);
+  mu_assert(query != NULL, "Query did not compile.");
+  mu_assert_int_eq(3, (int)List_Remove_Query(&list, query));
+  Query_Free(query);
+  mu_assert(list.active == NULL, "Removed active item should be cleared.");
+  mu_assert_int_eq(2, (int)List_Length(list));
+  mu_assert_double_eq(2, list.first->next->data.age);
+
+  List_Order_Detach(&list);
+  while (list.first != NULL) {
+    List_Delete_First(&list);
+  }
+}
+
+MU_TEST(test_list_reverse_split_partition) {
+  Data_t data = {.age = 0, .weight = 0, .height = 0, .name = "Relink"};
+  List_Node_t *last = NULL;
+  List_Node_t *node;
+  List_Lazy_t lazy;
+  List_t list, tail;
+  size_t position;
+  int calls = 0;
+  List_Init(&list);
+  List_Init(&tail);
+
+  for (int i = 0; i < 10; i++) {
+    data.age = i;
+    last = List_Insert_After(&list, last, data);
+  }
+  mu_assert(List_Order_Attach(&list), "Attaching the index failed.");
+  List_Seek(&list, 3);
+  List_Reverse(&list);
+  node = list.first;
+  for (int i = 9; i >= 0; i--, node = node->next) {
+    mu_assert_double_eq(i, node->data.age);
+  }
+  mu_assert_double_eq(3, list.active->data.age);
+  mu_assert(List_Position(list, &position), "Position failed.");
+  mu_assert_int_eq(6, (int)position);
+
+  /* 9 8 ... 0 -> 9 7 5 3 1 8 6 4 2 0 */
+  mu_assert_int_eq(5, (int)List_Partition(&list, remove_test_odd_age, &calls));
+  mu_assert_int_eq(10, calls);
+  node = list.first;
+  for (int i = 0; i < 10; i++, node = node->next) {
+    mu_assert_double_eq(i < 5 ? 9 - 2 * i : 8 - 2 * (i - 5), node->data.age);
+  }
+  mu_assert(node == NULL, "Partition lost the end of the list.");
+  mu_assert(List_Position(list, &position), "Position failed.");
+  mu_assert_int_eq(3, (int)position);
+
+  mu_assert(List_Bloom_Attach(&tail, 16, 0.01), "Attaching the filter failed.");
+  mu_assert(List_Lazy_Attach(&list, &lazy, 0), "Lazy mode not set.");
+  mu_assert(!List_Split_At_Active(&list, &list), "Split into itself.");
+  mu_assert(List_Split_At_Active(&list, &tail), "Split failed.");
+  mu_assert_int_eq(4, (int)List_Length(list));
+  mu_assert_int_eq(4, (int)lazy.live);
+  mu_assert(list.active->next == NULL, "Active item should be the last.");
+  mu_assert_int_eq(6, (int)List_Length(tail));
+  mu_assert_double_eq(1, tail.first->data.age);
+  mu_assert(List_Maybe_Contains_Name(tail, "Relink"), "Tail filter not filled.");
+  List_First(&tail);
+  mu_assert(!List_Split_At_Active(&tail, &list), "Split into a non-empty list.");
+
+  List_Lazy_Attach(&list, NULL, 0);
+  List_Order_Detach(&list);
+  List_Bloom_Detach(&tail);
+  while (list.first != NULL) {
+    List_Delete_First(&list);
+  }
+  while (tail.first != NULL) {
+    List_Delete_First(&tail);
+  }
+}
+
+MU_TEST(test_list_top_k) {
+  Data_t data = {.age = 0, .weight = 0, .height = 0, .name = "TopK"};
+  const List_Node_t *top[10], *parallel[10], **all;
+  List_Node_t *last = NULL;
+  List_t list;
+  List_Init(&list);
+
+  mu_assert_int_eq(0, (int)List_Top_K(list, DATA_FIELD_AGE, 10, true, top));
+  /* weights 0..99 999 in a scrambled order, age 7 everywhere */
+  for (int i = 0; i < 100000; i++) {
+    data.age = 7;
+    data.weight = (double)((i * 7919L) % 100000);
+    last = List_Insert_After(&list, last, data);
+  }
+  mu_assert_int_eq(0, (int)List_Top_K(list, DATA_FIELD_NAME, 10, true, top));
+  mu_assert_int_eq(10, (int)List_Top_K(list, DATA_FIELD_WEIGHT, 10, true, top));
+  for (int i = 0; i < 10; i++) {
+    mu_assert_double_eq(99999 - i, top[i]->data.weight);
+  }
+  mu_assert_int_eq(10, (int)List_Top_K(list, DATA_FIELD_WEIGHT, 10, false, top));
+  for (int i = 0; i < 10; i++) {
+    mu_assert_double_eq(i, top[i]->data.weight);
+  }
+  /* equal values keep the order of the list */
+  mu_assert_int_eq(3, (int)List_Top_K(list, DATA_FIELD_AGE, 3, true, top));
+  mu_assert(top[0] == list.first && top[1] == list.first->next &&
+                top[2] == list.first->next->next,
+            "Ties are not in the order of the list.");
+
+  mu_assert(List_Order_Attach(&list), "Attaching the index failed.");
+  mu_assert_int_eq(10, (int)List_Top_K(list, DATA_FIELD_WEIGHT, 10, false, top));
+  mu_assert_int_eq(10, (int)List_Top_K_Parallel(list, DATA_FIELD_WEIGHT, 10, false,
+                                                4, parallel));
+  mu_assert(memcmp(top, parallel, sizeof(top)) == 0,
+            "Parallel result differs from the sequential one.");
+  mu_assert_int_eq(10, (int)List_Top_K_Parallel(list, DATA_FIELD_AGE, 10, true, 4,
+                                                parallel));
+  mu_assert(parallel[9] == list.first->next->next->next->next->next->next->next
+                               ->next->next,
+            "Parallel ties are not in the order of the list.");
+
+  /* the heaps grow with the items, a k far beyond the list costs nothing */
+  all = malloc(2 * 100000 * sizeof(*all));
+  mu_assert(all != NULL, "Out of memory.");
+  mu_assert_int_eq(100000, (int)List_Top_K(list, DATA_FIELD_WEIGHT, (size_t)1 << 40, true,
+                                           all));
+  mu_assert_int_eq(100000, (int)List_Top_K_Parallel(list, DATA_FIELD_WEIGHT,
+                                                    (size_t)1 << 40, true, 4, all + 100000));
+  mu_assert(memcmp(all, all + 100000, 100000 * sizeof(*all)) == 0,
+            "Parallel result differs from the sequential one.");
+  mu_assert_double_eq(0, all[99999]->data.weight);
+  free(all);
+
+  List_Order_Detach(&list);
+  while (list.first != NULL) {
+    List_Delete_First(&list);
+  }
+}
+
+static bool sketch_test_close(double expected, double actual) {
+  double error = (actual - expected) / expected;
+  return error <= 0.01 && error >= -0.01;
+}
+
+MU_TEST(test_list_sketch) {
+  Data_t data = {.age = 0, .weight = 0, .height = 0, .name = "Sketch"};
+  const double qs[] = {0, 0.5, 0.95, 0.99, 1};
+  Sketch_t merged, negative;
+  double exact, estimate;
+  List_t list;
+  List_Init(&list);
+
+  mu_assert(!List_Quantile(list, DATA_FIELD_WEIGHT, 0.5, &exact),
+            "Quantile of an empty list.");
+  for (int i = 1; i <= 10000; i++) {
+    data.weight = i;
+    data.age = 1.0 / i;
+    List_Insert_First(&list, data);
+  }
+  mu_assert(!List_Sketch_Attach(&list, 0), "Accuracy 0 accepted.");
+  mu_assert(List_Sketch_Attach(&list, 0.01), "Attaching the sketches failed.");
+  mu_assert(!List_Sketch_Attach(&list, 0.01), "Second sketches attached.");
+  mu_assert(List_Sketch(list, DATA_FIELD_NAME) == NULL, "Sketch of the name.");
+  mu_assert(!List_Quantile(list, DATA_FIELD_WEIGHT, 1.5, &exact), "q above 1.");
+
+  /* delete the 100 heaviest, halve the next one */
+  for (int i = 0; i < 100; i++) {
+    List_Delete_First(&list);
+  }
+  List_First(&list);
+  List_Copy(list, &data);
+  data.weight /= 2;
+  List_Actualize(&list, data);
+
+  for (size_t i = 0; i < sizeof(qs) / sizeof(qs[0]); i++) {
+    mu_assert(List_Quantile(list, DATA_FIELD_WEIGHT, qs[i], &estimate),
+              "Quantile from the sketch failed.");
+    List_t plain = list;
+    plain.ext = NULL; /* without the sketches the quantile is exact */
+    mu_assert(List_Quantile(plain, DATA_FIELD_WEIGHT, qs[i], &exact),
+              "Exact quantile failed.");
+    mu_assert(sketch_test_close(exact, estimate), "Weight quantile off by over 1 %.");
+  }
+  mu_assert(List_Quantile(list, DATA_FIELD_AGE, 0.5, &estimate), "Age quantile failed.");
+  mu_assert(sketch_test_close(1.0 / 4951, estimate), "Age quantile off by over 1 %.");
+
+  /* merging, zero and negative values */
+  mu_assert(Sketch_Init(&merged, 0.01), "Init failed.");
+  mu_assert(Sketch_Init(&negative, 0.01), "Init failed.");
+  for (int i = 0; i < 100; i++) {
+    mu_assert(Sketch_Add(&negative, -1 - i), "Add failed.");
+  }
+  mu_assert(Sketch_Add(&negative, 0), "Add failed.");
+  mu_assert(Sketch_Merge(&merged, List_Sketch(list, DATA_FIELD_WEIGHT)), "Merge failed.");
+  mu_assert(Sketch_Merge(&merged, &negative), "Merge failed.");
+  mu_assert_int_eq(10001, (int)merged.count);
+  mu_assert(Sketch_Quantile(&merged, 0, &estimate), "Quantile failed.");
+  mu_assert(sketch_test_close(-100, estimate), "Minimum off by over 1 %.");
+  mu_assert(Sketch_Quantile(&merged, 100.0 / 10000, &estimate), "Quantile failed.");
+  mu_assert_double_eq(0, estimate);
+  Sketch_Remove(&merged, 0);
+  Sketch_Free(&negative);
+  Sketch_Free(&merged);
+
+  List_Sketch_Detach(&list);
+  while (list.first != NULL) {
+    List_Delete_First(&list);
+  }
+}
+
+MU_TEST(test_list_aggregate) {
+  Data_t data = {.age = 0, .weight = 0, .height = 0, .name = "Aggregate"};
+  double sum, mean, stddev;
+  List_t list;
+  List_Init(&list);
+
+  mu_assert(List_Aggregate_Attach(&list), "Attaching the aggregates failed.");
+  mu_assert(!List_Aggregate_Attach(&list), "Second aggregates attached.");
+  mu_assert(!List_Mean(list, DATA_FIELD_AGE, &mean), "Mean of an empty list.");
+  mu_assert(!List_Sum(list, DATA_FIELD_NAME, &sum), "Sum of the name.");
+
+  /* heights 1e9 + 1 ... 1e9 + 4: a large mean and a small spread */
+  for (int i = 1; i <= 4; i++) {
+    data.age = i;
+    data.height = 1e9 + i;
+    List_Insert_First(&list, data);
+  }
+  data.age = NAN;
+  data.height = 1e9 + 2.5;
+  List_Insert_First(&list, data);
+  mu_assert_int_eq(5, (int)List_Count(list));
+  mu_assert(List_Sum(list, DATA_FIELD_AGE, &sum), "Sum failed.");
+  mu_assert_double_eq(10, sum);
+  mu_assert(List_Stddev(list, DATA_FIELD_HEIGHT, &stddev), "Stddev failed.");
+  mu_assert_double_eq(1, stddev);
+
+  /* delete the NaN item and the age 3 item, the age 4 item becomes 10 */
+  List_Delete_First(&list);
+  List_First(&list);
+  List_Post_Delete(&list);
+  List_Copy(list, &data);
+  data.age = 10;
+  List_Actualize(&list, data);
+  mu_assert_int_eq(3, (int)List_Count(list));
+  mu_assert(List_Mean(list, DATA_FIELD_AGE, &mean), "Mean failed.");
+  mu_assert_double_eq(13.0 / 3, mean);
+
+  /* the same answers by traversal */
+  List_Aggregate_Detach(&list);
+  mu_assert_int_eq(3, (int)List_Count(list));
+  mu_assert(List_Mean(list, DATA_FIELD_AGE, &mean), "Mean failed.");
+  mu_assert_double_eq(13.0 / 3, mean);
+
+  /* many updates do not drift */
+  mu_assert(List_Aggregate_Attach(&list), "Attaching the aggregates failed.");
+  List_First(&list);
+  for (int i = 0; i < 100000; i++) {
+    data.weight = 0.1 * (i % 7);
+    List_Actualize(&list, data);
+  }
+  data.weight = 0;
+  List_Actualize(&list, data);
+  mu_assert(List_Sum(list, DATA_FIELD_WEIGHT, &sum), "Sum failed.");
+  mu_assert_double_eq(0, sum);
+
+  while (list.first != NULL) {
+    List_Delete_First(&list);
+  }
+  mu_assert_int_eq(0, (int)List_Count(list));
+  List_Aggregate_Detach(&list);
+}
+
+MU_TEST(test_list_lazy_delete) {
+  Data_t data = {.age = 0, .weight = 0, .height = 0, .name = "Lazy"};
+  List_Lazy_t lazy;
+  size_t dead;
+  List_t list;
+  List_Init(&list);
+
+  for (int i = 0; i < 10; i++) {
+    List_Insert_First(&list, data);
+  }
+  mu_assert(!List_Lazy_Attach(&list, &lazy, -1), "Negative ratio accepted.");
+  mu_assert(List_Lazy_Attach(&list, &lazy, 0), "Lazy mode not set.");
+  mu_assert_int_eq(10, (int)lazy.live);
+  List_First(&list);
+  List_Delete_First(&list);
+  mu_assert(list.active == NULL, "Deleted active item should be cleared.");
+  List_First(&list);
+  List_Post_Delete(&list);
+  List_Post_Delete(&list);
+  mu_assert_int_eq(3, (int)lazy.deadCount);
+  mu_assert_int_eq(7, (int)lazy.live);
+  mu_assert_int_eq(7, (int)List_Length(list));
+  mu_assert_int_eq(3, (int)List_Reclaim(&list));
+  mu_assert(lazy.dead == NULL, "Dead items left after reclaim.");
+
+  /* 207 items: the 104th delete leaves more dead items than live ones and
+   * releases 4 of them, the next ones release 4 until the ratio holds */
+  mu_assert(List_Lazy_Attach(&list, &lazy, 1), "Lazy mode not set.");
+  for (int i = 0; i < 200; i++) {
+    List_Insert_First(&list, data);
+  }
+  for (int i = 0; i < 103; i++) {
+    List_Delete_First(&list);
+  }
+  mu_assert_int_eq(103, (int)lazy.deadCount);
+  List_Delete_First(&list);
+  mu_assert_int_eq(100, (int)lazy.deadCount);
+  mu_assert_int_eq(103, (int)lazy.live);
+  List_Delete_First(&list);
+  mu_assert_int_eq(101, (int)lazy.deadCount);
+  for (int i = 0; i < 10; i++) {
+    List_Delete_First(&list);
+    mu_assert(lazy.deadCount <= lazy.live + 4, "Dead items not bounded.");
+  }
+  dead = lazy.deadCount;
+  mu_assert_int_eq((int)dead, (int)List_Reclaim(&list));
+
+  List_Delete_First(&list);
+  mu_assert(List_Lazy_Attach(&list, NULL, 0), "Lazy mode not cleared.");
+  mu_assert(list.ext == NULL, "Lazy mode not cleared.");
+  while (list.first != NULL) {
+    List_Delete_First(&list);
+  }
+}
+
+#ifdef __linux__
+MU_TEST(test_list_arena) {
+  Data_t data = {.age = 0, .weight = 0, .height = 0, .name = "Arena"};
+  List_Node_t *outside, *reused;
+  List_t list;
+  List_Init(&list);
+
+  List_Insert_First(&list, data);
+  outside = list.first;
+  mu_assert(List_Arena_Attach(&list, 4, true), "Arena was not attached.");
+  mu_assert(!List_Arena_Attach(&list, 4, true), "Second arena attached.");
+  for (int i = 0; i < 4; i++) {
+    data.age = i;
+    List_Insert_First(&list, data);
+  }
+  mu_assert(list.first->next == (List_Node_t *)((char *)list.first - sizeof(List_Node_t)),
+            "Arena items should be adjacent.");
+  List_Insert_First(&list, data);
+  mu_assert_int_eq(6, (int)List_Length(list));
+
+  List_Delete_First(&list); /* from myMalloc, the arena was full */
+  reused = list.first->next;
+  List_First(&list);
+  List_Post_Delete(&list);
+  List_Insert_First(&list, data);
+  mu_assert(list.first == reused, "Released arena item was not reused.");
+  mu_assert(!List_Arena_Detach(&list), "Detached an arena in use.");
+
+  while (list.first != outside) {
+    List_Delete_First(&list);
+  }
+  mu_assert(List_Arena_Detach(&list), "Empty arena was not detached.");
+  mu_assert(list.ext == NULL, "Detach should clear the arena.");
+  List_Delete_First(&list);
+}
+#endif
+
+MU_TEST(test_list_ext) {
+  Data_t data = {.age = 0, .weight = 0, .height = 0, .name = "Ext"};
+  List_Lazy_t lazy;
+  List_t list, moved;
+  List_Init(&list);
+
+#ifndef LIST_STATS
+  mu_assert_int_eq((int)(3 * sizeof(void *)), (int)sizeof(List_t));
+#endif
+  for (int i = 0; i < 3; i++) {
+    List_Insert_First(&list, data);
+  }
+  mu_assert(list.ext == NULL, "Plain list has attachments.");
+  mu_assert(List_Order_Attach(&list), "Index not attached.");
+  mu_assert(List_Lazy_Attach(&list, &lazy, 0), "Lazy mode not set.");
+  mu_assert(list.ext != NULL, "Attachments not allocated.");
+
+  /* the attachments move with the struct */
+  moved = list;
+  List_Init(&list);
+  mu_assert(List_Order_Attached(moved), "Moved list lost its index.");
+  List_Delete_First(&moved);
+  mu_assert_int_eq(1, (int)lazy.deadCount);
+  mu_assert_int_eq(2, (int)List_Length(moved));
+  List_Order_Detach(&moved);
+  mu_assert(moved.ext != NULL, "Lazy state was dropped with the index.");
+  List_Lazy_Attach(&moved, NULL, 0);
+  mu_assert(moved.ext == NULL, "Empty attachments not freed.");
+
+  mu_assert(List_Order_Attach(&moved), "Index not attached.");
+  mu_assert(List_Bloom_Attach(&moved, 16, 0.01), "Filter not attached.");
+  mu_assert(List_Sketch_Attach(&moved, 0.01), "Sketches not attached.");
+  mu_assert(List_Aggregate_Attach(&moved), "Aggregates not attached.");
+  mu_assert(List_Lazy_Attach(&moved, &lazy, 0), "Lazy mode not set.");
+#ifdef __linux__
+  mu_assert(List_Arena_Attach(&moved, 16, false), "Arena not attached.");
+#endif
+  List_Insert_First(&moved, data);
+  List_Delete_First(&moved);
+  List_Free(&moved);
+  mu_assert(moved.first == NULL, "List_Free left items.");
+  mu_assert(moved.ext == NULL, "List_Free left attachments.");
+}
+
+MU_TEST(test_ilist) {
+  Data_t data = {.age = 0, .weight = 0, .height = 0, .name = "Index"};
+  IList_t list, moved;
+  List_t pointers;
+  List_Init(&pointers);
+  IList_Init(&list);
+
+  mu_assert(!IList_Post_Insert(&list, data), "Insert without an active item.");
+  mu_assert(!IList_Copy_First(&list, &data), "Copy_First of an empty list.");
+  for (int i = 0; i < 100; i++) {
+    data.age = i;
+    mu_assert(IList_Insert_First(&list, data), "Insert failed.");
+  }
+  mu_assert_int_eq(100, (int)IList_Count(&list));
+  mu_assert(list.capacity >= 101 && list.data != NULL, "Arrays did not grow.");
+
+  /* 99 98 ... 0: keep every other item, 99 97 ... 1 */
+  for (IList_First(&list); IList_Is_Active(&list); IList_Succ(&list)) {
+    IList_Post_Delete(&list);
+  }
+  mu_assert_int_eq(50, (int)IList_Count(&list));
+  mu_assert(IList_Seek(&list, 49), "Seek failed.");
+  mu_assert(IList_Copy(&list, &data), "Copy failed.");
+  mu_assert_double_eq(1, data.age);
+  mu_assert(!IList_Seek(&list, 50), "Seek past the end.");
+
+  /* released indices are reused before the arrays grow */
+  data.age = 1000;
+  mu_assert(IList_Post_Insert(&list, data), "Post_Insert failed.");
+  mu_assert(list.used == 101, "A released index was not reused.");
+  IList_Succ(&list);
+  data.age = 2000;
+  IList_Actualize(&list, data);
+  IList_First(&list);
+  IList_Delete_First(&list);
+  mu_assert(!IList_Is_Active(&list), "Deleted active item should be cleared.");
+
+  /* the arrays are relocatable: a byte copy is the same list */
+  moved = list;
+  moved.data = malloc(list.capacity * sizeof(Data_t));
+  moved.next = malloc(list.capacity * sizeof(uint32_t));
+  mu_assert(moved.data != NULL && moved.next != NULL, "Out of memory.");
+  memcpy(moved.data, list.data, list.capacity * sizeof(Data_t));
+  memcpy(moved.next, list.next, list.capacity * sizeof(uint32_t));
+  IList_Free(&list);
+  mu_assert(list.data == NULL && IList_Count(&list) == 0, "Free left items.");
+
+  mu_assert(IList_Export(&moved, &pointers), "Export failed.");
+  mu_assert_int_eq(50, (int)List_Length(pointers));
+  mu_assert_double_eq(97, pointers.first->data.age);
+  mu_assert(IList_Reserve(&list, 1000), "Reserve failed.");
+  mu_assert(list.capacity == 1001, "Reserve did not size the arrays.");
+  mu_assert(IList_Import(&list, pointers), "Import failed.");
+  mu_assert(IList_Seek(&list, 49), "Seek failed.");
+  mu_assert(IList_Copy(&list, &data), "Copy failed.");
+  mu_assert_double_eq(2000, data.age);
+
+  IList_Free(&moved);
+  IList_Free(&list);
+  while (pointers.first != NULL) {
+    List_Delete_First(&pointers);
+  }
+}
+
+#ifdef __linux__
+MU_TEST(test_plist_reopen) {
+  const char *path = "test_plist.tmp";
+  Data_t data = {.age = 0, .weight = 70, .height = 180, .name = "Persistent"};
+  PList_t plist, other;
+  List_t list;
+  int count = 0;
+  remove(path);
+
+  mu_assert(PList_Open(&plist, path), "Opening a new persistent list failed.");
+  mu_assert(!PList_Open(&other, path), "The file should be locked.");
+  for (int i = 0; i < 5000; i++) {
+    data.age = i;
+    mu_assert(PList_Insert_First(&plist, data), "Insert failed.");
+  }
+  PList_First(&plist);
+  PList_Post_Delete(&plist); /* 4998 */
+  PList_Delete_First(&plist); /* 4999, was active */
+  mu_assert(!PList_Is_Active(&plist), "Deleted active item should be cleared.");
+  PList_First(&plist);
+  PList_Succ(&plist);
+  data.age = -1;
+  mu_assert(PList_Post_Insert(&plist, data), "Post_Insert failed.");
+  mu_assert(PList_Close(&plist), "Closing failed.");
+
+  mu_assert(PList_Open(&plist, path), "Reopening failed.");
+  mu_assert_int_eq(4999, (int)PList_Count(&plist));
+  mu_assert(PList_Copy(&plist, &data), "Active item was not kept.");
+  mu_assert_double_eq(4996, data.age);
+  PList_Succ(&plist);
+  PList_Copy(&plist, &data);
+  mu_assert_double_eq(-1, data.age);
+  PList_Copy_First(&plist, &data);
+  mu_assert_double_eq(4997, data.age);
+
+  List_Init(&list);
+  mu_assert(PList_Export(&plist, &list), "Export failed.");
+  for (List_Node_t *node = list.first; node != NULL; node = node->next) {
+    count++;
+  }
+  mu_assert_int_eq(4999, count);
+  mu_assert(PList_Import(&plist, list), "Import failed.");
+  mu_assert_int_eq(9998, (int)PList_Count(&plist));
+  mu_assert(PList_Close(&plist), "Closing failed.");
+  while (list.first != NULL) {
+    List_Delete_First(&list);
+  }
+  remove(path);
+}
+#endif
+
+#ifdef __linux__
+static int server_test_connect(const char *path) {
+  struct sockaddr_un addr;
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, path);
+  if (fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+    return -1;
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  return fd;
+}
+
+/* Polls the server until the client has received len bytes, returns the
+ * number of received bytes, -1 if the server closed the connection */
+static int server_test_receive(Server_t *server, int fd, unsigned char *buf,
+                               size_t len) {
+  size_t got = 0;
+  for (int i = 0; i < 100 && got < len; i++) {
+    ssize_t n;
+    Server_Poll(server, 10);
+    n = read(fd, buf + got, len - got);
+    if (n == 0)
+      return -1;
+    if (n > 0)
+      got += (size_t)n;
+  }
+  return (int)got;
+}
+
+MU_TEST(test_server_shared_list) {
+  const char *path = "test_server.sock";
+  Data_t john = {.age = 23, .weight = 70, .height = 150, .name = "John"};
+  Data_t anna = {.age = 19, .weight = 56, .height = 158, .name = "Anna"};
+  unsigned char req[2 * DATA_ENCODED_MAX + 8];
+  unsigned char resp[DATA_ENCODED_MAX + 8];
+  Server_t *server;
+  Data_t data;
+  List_t list;
+  size_t len = 0;
+  int a, b;
+  List_Init(&list);
+  server = Server_Open(&list, path);
+  mu_assert(server != NULL, "Opening server failed.");
+  a = server_test_connect(path);
+  b = server_test_connect(path);
+  mu_assert(a >= 0 && b >= 0, "Connecting to server failed.");
+
+  /* pipelined: Insert_First x2, First, Copy, Succ */
+  req[len++] = TRACE_OP_INSERT_FIRST;
+  len += Data_Encode(&john, req + len);
+  req[len++] = TRACE_OP_INSERT_FIRST;
+  len += Data_Encode(&anna, req + len);
+  req[len++] = TRACE_OP_FIRST;
+  req[len++] = TRACE_OP_COPY;
+  req[len++] = TRACE_OP_SUCC;
+  mu_assert(write(a, req, len) == (ssize_t)len, "Sending requests failed.");
+  len = 4 + 1 + Data_Encode(&anna, resp);
+  mu_assert_int_eq((int)len, server_test_receive(server, a, resp, len));
+  mu_assert_int_eq(SERVER_STATUS_OK, resp[0]);
+  mu_assert_int_eq(SERVER_STATUS_OK, resp[2]);
+  mu_assert_int_eq(SERVER_STATUS_RECORD, resp[3]);
+  mu_assert(Data_Decode(resp + 4, len - 4, &data) > 0, "Bad record.");
+  mu_assert_string_eq("Anna", data.name);
+  mu_assert_int_eq(SERVER_STATUS_OK, resp[len - 1]);
+
+  /* b has its own cursor and deletes the active item of a */
+  req[0] = TRACE_OP_IS_ACTIVE;
+  req[1] = TRACE_OP_FIRST;
+  req[2] = TRACE_OP_POST_DELETE;
+  mu_assert(write(b, req, 3) == 3, "Sending requests failed.");
+  mu_assert_int_eq(3, server_test_receive(server, b, resp, 3));
+  mu_assert_int_eq(SERVER_STATUS_FALSE, resp[0]);
+  mu_assert_int_eq(SERVER_STATUS_OK, resp[1]);
+  mu_assert_int_eq(SERVER_STATUS_OK, resp[2]);
+  mu_assert_string_eq("Anna", list.first->data.name);
+  mu_assert(list.first->next == NULL, "Post_Delete of b failed.");
+
+  req[0] = TRACE_OP_IS_ACTIVE;
+  req[1] = 0xFF;
+  mu_assert(write(a, req, 2) == 2, "Sending requests failed.");
+  mu_assert_int_eq(2, server_test_receive(server, a, resp, 2));
+  mu_assert_int_eq(SERVER_STATUS_FALSE, resp[0]);
+  mu_assert_int_eq(SERVER_STATUS_BAD, resp[1]);
+  mu_assert_int_eq(-1, server_test_receive(server, a, resp, 1));
+
+  close(a);
+  close(b);
+  Server_Close(server);
+  mu_assert(access(path, F_OK) != 0, "Socket file should be removed.");
+  while (list.first != NULL) {
+    List_Delete_First(&list);
+  }
+}
+#endif
+
 MU_TEST_SUITE(test_suite) {
   MU_RUN_TEST(test_initialize_list);
   MU_RUN_TEST(test_initialize_list_nulls);
@@ -295,6 +1481,38 @@ MU_TEST_SUITE(test_suite) {
   MU_RUN_TEST(test_list_succ);
   MU_RUN_TEST(test_list_succ_nulls);
   MU_RUN_TEST(test_is_active);
+  MU_RUN_TEST(test_parse_double);
+  MU_RUN_TEST(test_data_format);
+  MU_RUN_TEST(test_list_dump);
+  MU_RUN_TEST(test_reader_lines);
+  MU_RUN_TEST(test_load_buffer);
+  MU_RUN_TEST(test_load_text_parallel);
+#ifdef __linux__
+  MU_RUN_TEST(test_snapshot_save_load);
+#endif
+  MU_RUN_TEST(test_csv_export_import);
+  MU_RUN_TEST(test_trace_record_replay);
+  MU_RUN_TEST(test_query_compile_match);
+  MU_RUN_TEST(test_list_stats);
+  MU_RUN_TEST(test_list_order);
+  MU_RUN_TEST(test_list_bloom);
+  MU_RUN_TEST(test_list_remove_if);
+  MU_RUN_TEST(test_list_reverse_split_partition);
+  MU_RUN_TEST(test_list_top_k);
+  MU_RUN_TEST(test_list_sketch);
+  MU_RUN_TEST(test_list_aggregate);
+  MU_RUN_TEST(test_list_lazy_delete);
+#ifdef __linux__
+  MU_RUN_TEST(test_list_arena);
+#endif
+  MU_RUN_TEST(test_list_ext);
+#ifdef __linux__
+  MU_RUN_TEST(test_plist_reopen);
+#endif
+  MU_RUN_TEST(test_ilist);
+#ifdef __linux__
+  MU_RUN_TEST(test_server_shared_list);
+#endif
 }
 
 int main(void) {
@@ -0,0 +1,268 @@
+/**
+ * @file       footprint.c
+ * @date       10/2026
+ * @brief      Measures the memory footprint of lists per storage mode
+ * **********************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * Usage: footprint [records...]
+ *
+ * For every storage mode in the modes table and every record count
+ * (default 1000000) a child process builds the records and reports the
+ * growth of its resident set (/proc/self/statm) and of the malloc heap
+ * (mallinfo2, glibc 2.33 and newer). Heap growth minus the bytes the mode
+ * asked for is the allocator overhead (block headers, alignment padding).
+ * Running every measurement in a fresh process keeps memory freed by one
+ * mode from being reused by the next one.
+ *
+ * New storage modes are added as one more entry of the modes table.
+ */
+
+#define _DEFAULT_SOURCE
+
+/* Private includes -------------------------------------------------------- */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#if __GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33)
+#define HAVE_MALLINFO2 1
+#endif
+#endif
+#include "../src/arena.h"
+#include "../src/ilist.h"
+#include "../src/list.h"
+#include "../src/order.h"
+
+#define DEFAULT_RECORDS 1000000L
+
+typedef struct {
+    long long rss;      /**< resident set in bytes, -1 if unknown */
+    long long heapUsed; /**< bytes in allocated malloc blocks, -1 if unknown */
+    long long heapOs;   /**< bytes malloc obtained from the system, -1 if unknown */
+} Footprint_Sample_t;
+
+typedef struct {
+    bool ok;
+    long long requested; /**< bytes requested by the mode from the allocator */
+    Footprint_Sample_t delta;
+} Footprint_Result_t;
+
+typedef struct {
+    const char* name;
+    const char* description;
+    bool mapped; /**< memory comes from mmap, the heap columns do not apply */
+    /** builds the records, adds requested bytes, returns false when out of memory */
+    bool (*build)(long records, long long* requested);
+} Footprint_Mode_t;
+
+/* Private functions ------------------------------------------------------- */
+
+static void make_data(Data_t* data, long i) {
+    snprintf(data->name, sizeof(data->name), "Record %ld", i);
+    data->age = (double)(i % 90);
+    data->weight = 50.0 + (double)(i % 50);
+    data->height = 150.0 + (double)(i % 50);
+}
+
+static bool fill_list(List_t* list, long records, long long* requested) {
+    Data_t data;
+
+    for(long i = 0; i < records; i++) {
+        make_data(&data, i);
+        if(!List_Insert_After(list, NULL, data))
+            return false;
+    }
+    *requested += (long long)records * (long long)sizeof(List_Node_t);
+    return true;
+}
+
+static bool build_list(long records, long long* requested) {
+    List_t list;
+
+    List_Init(&list);
+    return fill_list(&list, records, requested);
+}
+
+/* the index reports no requested bytes, so its whole size shows as overhead */
+static bool build_order(long records, long long* requested) {
+    List_t list;
+
+    List_Init(&list);
+    return fill_list(&list, records, requested) && List_Order_Attach(&list);
+}
+
+static bool build_arena(long records, long long* requested) {
+    List_t list;
+
+    List_Init(&list);
+    return List_Arena_Attach(&list, (size_t)records, true) &&
+           fill_list(&list, records, requested);
+}
+
+static bool build_ilist(long records, long long* requested) {
+    IList_t list;
+    Data_t data;
+
+    IList_Init(&list);
+    if(!IList_Reserve(&list, (size_t)records))
+        return false;
+    for(long i = 0; i < records; i++) {
+        make_data(&data, i);
+        if(!IList_Insert_First(&list, data))
+            return false;
+    }
+    *requested += (long long)records * (long long)(sizeof(Data_t) + sizeof(uint32_t));
+    return true;
+}
+
+/* reference only: the records encoded by Data_Encode back to back */
+static bool build_packed(long records, long long* requested) {
+    unsigned char* buffer = malloc((size_t)records * DATA_ENCODED_MAX);
+    unsigned char* shrunk;
+    size_t used = 0;
+    Data_t data;
+
+    if(!buffer)
+        return false;
+    for(long i = 0; i < records; i++) {
+        make_data(&data, i);
+        used += Data_Encode(&data, buffer + used);
+    }
+    shrunk = realloc(buffer, used ? used : 1);
+    if(!shrunk)
+        return false;
+    *requested += (long long)used;
+    return true;
+}
+
+static const Footprint_Mode_t modes[] = {
+    {"list", "List_Node_t per record from myMalloc", false, build_list},
+    {"order", "list with an order-statistic index (index counted as overhead)", false,
+     build_order},
+    {"arena", "List_Node_t per record from the huge page node arena", true, build_arena},
+    {"ilist", "IList_t: data and 32-bit link arrays", false, build_ilist},
+    {"packed", "Data_Encode records in one block (reference, not a list)", false,
+     build_packed},
+};
+
+static Footprint_Sample_t sample(void) {
+    Footprint_Sample_t s = {-1, -1, -1};
+    FILE* f = fopen("/proc/self/statm", "r");
+    long long size, resident;
+
+    if(f) {
+        if(fscanf(f, "%lld %lld", &size, &resident) == 2)
+            s.rss = resident * sysconf(_SC_PAGESIZE);
+        fclose(f);
+    }
+#ifdef HAVE_MALLINFO2
+    {
+        struct mallinfo2 mi = mallinfo2();
+        s.heapUsed = (long long)(mi.uordblks + mi.hblkhd);
+        s.heapOs = (long long)(mi.arena + mi.hblkhd);
+    }
+#endif
+    return s;
+}
+
+static long long delta(long long after, long long before) {
+    return after < 0 || before < 0 ? -1 : after - before;
+}
+
+static Footprint_Result_t measure_child(const Footprint_Mode_t* mode, long records) {
+    Footprint_Result_t r;
+    Footprint_Sample_t before, after;
+
+    memset(&r, 0, sizeof(r));
+    before = sample();
+    r.ok = mode->build(records, &r.requested);
+    after = sample();
+    r.delta.rss = delta(after.rss, before.rss);
+    r.delta.heapUsed = delta(after.heapUsed, before.heapUsed);
+    r.delta.heapOs = delta(after.heapOs, before.heapOs);
+    return r;
+}
+
+static bool measure(const Footprint_Mode_t* mode, long records, Footprint_Result_t* r) {
+    int fds[2];
+    pid_t pid;
+    int status;
+    bool ok;
+
+    if(pipe(fds) != 0)
+        return false;
+    pid = fork();
+    if(pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if(pid == 0) {
+        Footprint_Result_t result = measure_child(mode, records);
+        close(fds[0]);
+        _exit(write(fds[1], &result, sizeof(result)) == (ssize_t)sizeof(result) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    ok = read(fds[0], r, sizeof(*r)) == (ssize_t)sizeof(*r);
+    close(fds[0]);
+    waitpid(pid, &status, 0);
+    return ok && r->ok;
+}
+
+static void print_per_record(long long bytes, long records) {
+    if(bytes < 0)
+        printf(" %10s", "n/a");
+    else
+        printf(" %10.1f", (double)bytes / records);
+}
+
+int main(int argc, char** argv) {
+    int result = 0;
+
+    for(int a = 1; a < argc; a++) {
+        if(atol(argv[a]) < 1) {
+            fprintf(stderr, "Invalid number of records: %s\n", argv[a]);
+            return 1;
+        }
+    }
+
+    printf("sizeof(Data_t) = %zu, sizeof(List_Node_t) = %zu, bytes per record:\n",
+           sizeof(Data_t), sizeof(List_Node_t));
+    printf("%-8s %10s %10s %10s %10s %10s %10s\n", "mode", "records", "requested",
+           "heap used", "overhead", "heap os", "rss");
+
+    for(int a = 1; a < argc || a == 1; a++) {
+        long records = a < argc ? atol(argv[a]) : DEFAULT_RECORDS;
+
+        for(size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+            Footprint_Result_t r;
+
+            if(!measure(&modes[m], records, &r)) {
+                printf("%-8s %10ld  failed\n", modes[m].name, records);
+                result = 1;
+                continue;
+            }
+            printf("%-8s %10ld", modes[m].name, records);
+            if(modes[m].mapped)
+                r.delta.heapUsed = r.delta.heapOs = -1;
+            print_per_record(r.requested, records);
+            print_per_record(r.delta.heapUsed, records);
+            print_per_record(r.delta.heapUsed < 0 ? -1 : r.delta.heapUsed - r.requested,
+                             records);
+            print_per_record(r.delta.heapOs, records);
+            print_per_record(r.delta.rss, records);
+            printf("\n");
+        }
+    }
+
+    printf("\nmodes:\n");
+    for(size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++)
+        printf("  %-8s %s\n", modes[m].name, modes[m].description);
+    return result;
+}
@@ -0,0 +1,281 @@
+/**
+ * @file       replay.c
+ * @date       10/2026
+ * @brief      Replays traces recorded by List -r through the List_* API at
+ * full speed and reports throughput and latency percentiles per operation
+ * **********************************************************************
+ * @par       COPYRIGHT NOTICE (c) 2019 TBU in Zlin. All rights reserved.
+ *
+ * Usage: replay [-n repeats] TRACE...
+ *
+ * The trace is decoded into memory before anything is measured. Every
+ * repeat starts with an empty list. The throughput pass runs the operations
+ * back to back without any timer calls, the latency pass reads the clock
+ * around every single operation, so its numbers include the timer overhead
+ * that is printed with them. Init frees the items of the list before
+ * List_Init, as the batch mode of List does.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/* Private includes -------------------------------------------------------- */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../src/data.h"
+#include "../src/list.h"
+#include "../src/trace.h"
+
+typedef struct {
+    unsigned char* ops;
+    Data_t* records;
+    size_t count;
+    size_t recordCount;
+} Trace_t;
+
+typedef struct {
+    uint32_t* ns;
+    size_t count;
+    size_t capacity;
+} Samples_t;
+
+static volatile double sink;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void list_free(List_t* list) {
+    while(list->first)
+        List_Delete_First(list);
+}
+
+static bool trace_load(const char* path, Trace_t* trace) {
+    Trace_Reader_t reader;
+    Trace_Op_t op;
+    Data_t data;
+    size_t ops = 0, records = 0;
+    size_t begin;
+    int rc;
+
+    memset(trace, 0, sizeof(*trace));
+    if(!Trace_Map(&reader, path))
+        return false;
+    begin = reader.pos;
+
+    while((rc = Trace_Next(&reader, &op, NULL)) == 1) {
+        ops++;
+        if(Trace_Op_Has_Data(op))
+            records++;
+    }
+    if(rc < 0) {
+        Trace_Unmap(&reader);
+        return false;
+    }
+
+    trace->ops = malloc(ops ? ops : 1);
+    trace->records = malloc((records ? records : 1) * sizeof(Data_t));
+    if(!trace->ops || !trace->records) {
+        Trace_Unmap(&reader);
+        return false;
+    }
+
+    reader.pos = begin;
+    while(Trace_Next(&reader, &op, &data) == 1) {
+        trace->ops[trace->count++] = (unsigned char)op;
+        if(Trace_Op_Has_Data(op))
+            trace->records[trace->recordCount++] = data;
+    }
+    Trace_Unmap(&reader);
+    return true;
+}
+
+static inline void execute(List_t* list, Trace_Op_t op, const Data_t** record) {
+    Data_t data;
+
+    switch(op) {
+    case TRACE_OP_INIT:
+        list_free(list);
+        List_Init(list);
+        break;
+    case TRACE_OP_ACTUALIZE:
+        List_Actualize(list, *(*record)++);
+        break;
+    case TRACE_OP_INSERT_FIRST:
+        List_Insert_First(list, *(*record)++);
+        break;
+    case TRACE_OP_FIRST:
+        List_First(list);
+        break;
+    case TRACE_OP_COPY_FIRST:
+        if(List_Copy_First(*list, &data))
+            sink = data.age;
+        break;
+    case TRACE_OP_DELETE_FIRST:
+        List_Delete_First(list);
+        break;
+    case TRACE_OP_POST_DELETE:
+        List_Post_Delete(list);
+        break;
+    case TRACE_OP_POST_INSERT:
+        List_Post_Insert(list, *(*record)++);
+        break;
+    case TRACE_OP_COPY:
+        if(List_Copy(*list, &data))
+            sink = data.age;
+        break;
+    case TRACE_OP_SUCC:
+        List_Succ(list);
+        break;
+    case TRACE_OP_IS_ACTIVE:
+        sink = List_Is_Active(*list);
+        break;
+    default:
+        break;
+    }
+}
+
+static double run_throughput(const Trace_t* trace, long repeats) {
+    uint64_t total = 0;
+
+    for(long r = 0; r < repeats; r++) {
+        const Data_t* record = trace->records;
+        List_t list;
+        uint64_t start;
+
+        List_Init(&list);
+        start = now_ns();
+        for(size_t i = 0; i < trace->count; i++)
+            execute(&list, (Trace_Op_t)trace->ops[i], &record);
+        total += now_ns() - start;
+        list_free(&list);
+    }
+    return total * 1e-9;
+}
+
+static void run_latency(const Trace_t* trace, long repeats, Samples_t* samples) {
+    for(long r = 0; r < repeats; r++) {
+        const Data_t* record = trace->records;
+        List_t list;
+
+        List_Init(&list);
+        for(size_t i = 0; i < trace->count; i++) {
+            Trace_Op_t op = (Trace_Op_t)trace->ops[i];
+            Samples_t* s = &samples[op];
+            uint64_t start = now_ns();
+            uint64_t elapsed;
+
+            execute(&list, op, &record);
+            elapsed = now_ns() - start;
+            s->ns[s->count++] = elapsed > UINT32_MAX ? UINT32_MAX : (uint32_t)elapsed;
+        }
+        list_free(&list);
+    }
+}
+
+static int compare_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+static uint32_t percentile(const Samples_t* s, double p) {
+    size_t rank = (size_t)(p / 100.0 * s->count + 0.999999);
+    if(rank == 0)
+        rank = 1;
+    if(rank > s->count)
+        rank = s->count;
+    return s->ns[rank - 1];
+}
+
+static uint32_t timer_overhead(void) {
+    uint32_t best = UINT32_MAX;
+    for(int i = 0; i < 1000; i++) {
+        uint64_t start = now_ns();
+        uint64_t elapsed = now_ns() - start;
+        if(elapsed < best)
+            best = (uint32_t)elapsed;
+    }
+    return best;
+}
+
+static bool replay(const char* path, long repeats) {
+    Samples_t samples[TRACE_OP_COUNT];
+    size_t perOp[TRACE_OP_COUNT] = {0};
+    Trace_t trace;
+    double seconds;
+    double total;
+    bool ok = true;
+
+    if(!trace_load(path, &trace)) {
+        fprintf(stderr, "%s: not a valid trace\n", path);
+        free(trace.ops);
+        free(trace.records);
+        return false;
+    }
+
+    for(size_t i = 0; i < trace.count; i++)
+        perOp[trace.ops[i]]++;
+    memset(samples, 0, sizeof(samples));
+    for(int op = 0; op < TRACE_OP_COUNT && ok; op++) {
+        samples[op].capacity = perOp[op] * (size_t)repeats;
+        samples[op].ns = malloc((samples[op].capacity ? samples[op].capacity : 1) *
+                                sizeof(uint32_t));
+        ok = samples[op].ns != NULL;
+    }
+
+    if(ok) {
+        total = (double)trace.count * repeats;
+        seconds = run_throughput(&trace, repeats);
+        run_latency(&trace, repeats, samples);
+
+        printf("%s: %zu operations x %ld repeats\n", path, trace.count, repeats);
+        printf("throughput: %.0f ops/s (%.1f ns/op)\n",
+               seconds > 0 ? total / seconds : 0.0,
+               total > 0 ? seconds * 1e9 / total : 0.0);
+        printf("latency in ns, timer overhead %u ns included:\n", timer_overhead());
+        printf("%-14s %10s %8s %8s %8s %8s %8s\n", "operation", "count", "p50", "p90",
+               "p99", "p99.9", "max");
+        for(int op = 0; op < TRACE_OP_COUNT; op++) {
+            Samples_t* s = &samples[op];
+            if(!s->count)
+                continue;
+            qsort(s->ns, s->count, sizeof(uint32_t), compare_u32);
+            printf("%-14s %10zu %8u %8u %8u %8u %8u\n", Trace_Op_Name((Trace_Op_t)op),
+                   s->count, percentile(s, 50), percentile(s, 90), percentile(s, 99),
+                   percentile(s, 99.9), s->ns[s->count - 1]);
+        }
+    } else {
+        fprintf(stderr, "%s: out of memory\n", path);
+    }
+
+    for(int op = 0; op < TRACE_OP_COUNT; op++)
+        free(samples[op].ns);
+    free(trace.ops);
+    free(trace.records);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    long repeats = 1;
+    int result = 0;
+    int i = 1;
+
+    if(i + 1 < argc && strcmp(argv[i], "-n") == 0) {
+        repeats = atol(argv[i + 1]);
+        i += 2;
+    }
+    if(i >= argc || repeats < 1) {
+        fprintf(stderr, "Usage: %s [-n repeats] TRACE...\n", argv[0]);
+        return 1;
+    }
+
+    for(; i < argc; i++) {
+        if(!replay(argv[i], repeats))
+            result = 1;
+    }
+    return result;
+}